@@ -29,6 +29,7 @@
 #include "../finder/building_placefinder.h"
 
 #include "../utils/cbuffer_t.h"
+#include "../utils/task_pool.h"
 
 #include "../descriptor/objversion.h"
 
@@ -36,6 +37,7 @@
 
 
 karte_ptr_t factory_builder_t::welt;
+task_pool_t *factory_builder_t::site_search_pool = NULL;
 
 /// Default factory spacing
 static int max_factory_spacing_general = 40;
@@ -408,6 +410,45 @@ bool factory_builder_t::check_construction_site(koord pos, koord size, factory_d
 }
 
 
+/// number of candidates of find_random_construction_site() in one task
+static const uint32 SITE_SEARCH_CHUNK = 64;
+
+/// a batch of candidates of find_random_construction_site()
+struct site_search_t
+{
+	koord pos;
+	int radius;
+	koord size;
+	factory_desc_t::site_t site;
+	bool is_factory;
+	climate_bits climates;
+	uint16 regions_allowed;
+	uint32 diam, area, a, c;
+	/// candidates in this batch
+	uint32 count;
+	/// the first index of the sequence of each task
+	uint32 first_index[MAX_THREADS * 4];
+	/// the first hit of each task, or koord::invalid
+	koord found[MAX_THREADS * 4];
+};
+
+
+void factory_builder_t::check_construction_sites_task(void *ptr, uint32 task)
+{
+	site_search_t *search = static_cast<site_search_t *>(ptr);
+	const uint32 count = min( SITE_SEARCH_CHUNK, search->count - task * SITE_SEARCH_CHUNK );
+	uint32 index = search->first_index[task];
+	search->found[task] = koord::invalid;
+	for(  uint32 i = 0;  i < count;  i++,  index = (search->a*index+search->c) % search->area  ) {
+		const koord k( search->pos.x - search->radius + (index % search->diam), search->pos.y - search->radius + (index / search->diam) );
+		if(  check_construction_site(k, search->size, search->site, search->is_factory, search->climates, search->regions_allowed)  ) {
+			search->found[task] = k;
+			return;
+		}
+	}
+}
+
+
 koord3d factory_builder_t::find_random_construction_site(koord pos, int radius, koord size, factory_desc_t::site_t site, const building_desc_t *desc, bool ignore_climates, uint32 max_iterations)
 {
 	bool is_factory = desc->get_type()==building_desc_t::factory;
@@ -432,20 +473,58 @@ koord3d factory_builder_t::find_random_construction_site(koord pos, int radius,
 	const uint32 a = diam+1;
 	const uint32 c = 37; // very unlikely to have this as a factor in somewhere ...
 
-	// in order to stop on the first occurence, one has to iterate over all tiles in a reproducable but random enough manner
-	for(  uint32 i = 0;  i<max_iterations; i++,  index = (a*index+c) % area  ) {
+	if(  site_search_pool  &&  max_iterations > SITE_SEARCH_CHUNK  ) {
+		// Check chunks of the same sequence in parallel. The first hit of the
+		// first chunk with a hit is the first hit of the serial search.
+		site_search_t search;
+		search.pos = pos;
+		search.radius = radius;
+		search.size = size;
+		search.site = site;
+		search.is_factory = is_factory;
+		search.climates = climates;
+		search.regions_allowed = desc->get_allowed_region_bits();
+		search.diam = diam;
+		search.area = area;
+		search.a = a;
+		search.c = c;
+		const uint32 max_tasks = site_search_pool->get_thread_count() * 4;
+		for(  uint32 done = 0;  done < max_iterations;  done += search.count  ) {
+			search.count = min( max_iterations - done, max_tasks * SITE_SEARCH_CHUNK );
+			const uint32 tasks = (search.count + SITE_SEARCH_CHUNK - 1) / SITE_SEARCH_CHUNK;
+			for(  uint32 i = 0;  i < search.count;  i++,  index = (a*index+c) % area  ) {
+				if(  i % SITE_SEARCH_CHUNK == 0  ) {
+					search.first_index[i / SITE_SEARCH_CHUNK] = index;
+				}
+			}
+			site_search_pool->run( check_construction_sites_task, &search, tasks );
+			for(  uint32 t = 0;  t < tasks;  t++  ) {
+				if(  search.found[t] != koord::invalid  ) {
+					k = search.found[t];
+					if (site != factory_desc_t::Water && site != factory_desc_t::Land) {
+						DBG_MESSAGE("factory_builder_t::find_random_construction_site","Found spot for %d at %s / %d\n", site, k.get_str(), max_iterations);
+					}
+					goto finish;
+				}
+			}
+		}
+	}
+	else {
+		// in order to stop on the first occurence, one has to iterate over all tiles in a reproducable but random enough manner
+		for(  uint32 i = 0;  i<max_iterations; i++,  index = (a*index+c) % area  ) {
 
-		// so it is guaranteed that the iteration hits all tiles and does not repeat itself
-		k = koord( pos.x - radius + (index % diam), pos.y - radius + (index / diam) );
+			// so it is guaranteed that the iteration hits all tiles and does not repeat itself
+			k = koord( pos.x - radius + (index % diam), pos.y - radius + (index / diam) );
 
-		// check place (it will actually check an grosse.x/y size rectangle, so we can iterate over less tiles)
-		if(  factory_builder_t::check_construction_site(k, size, site, is_factory, climates, desc->get_allowed_region_bits())  ) {
-			// then accept first hit
-			if (site != factory_desc_t::Water && site != factory_desc_t::Land) {
-				DBG_MESSAGE("factory_builder_t::find_random_construction_site","Found spot for %d at %s / %d\n", site, k.get_str(), max_iterations);
+			// check place (it will actually check an grosse.x/y size rectangle, so we can iterate over less tiles)
+			if(  factory_builder_t::check_construction_site(k, size, site, is_factory, climates, desc->get_allowed_region_bits())  ) {
+				// then accept first hit
+				if (site != factory_desc_t::Water && site != factory_desc_t::Land) {
+					DBG_MESSAGE("factory_builder_t::find_random_construction_site","Found spot for %d at %s / %d\n", site, k.get_str(), max_iterations);
+				}
+				// we accept first hit
+				goto finish;
 			}
-			// we accept first hit
-			goto finish;
 		}
 	}
 	// nothing found
@@ -16,6 +16,7 @@ class stadt_t;
 class karte_ptr_t;
 class player_t;
 class fabrik_t;
+class task_pool_t;
 
 
 /**
@@ -57,6 +58,9 @@ private:
 	 */
 	static void find_producer(weighted_vector_tpl<const factory_desc_t *> &producer, const goods_desc_t *ware, uint16 timeline );
 
+	/// threads for the site search, while set by set_site_search_pool()
+	static task_pool_t *site_search_pool;
+
 public:
 	/// This is only for the set_scale function in simworld.cc
 	static stringhashtable_tpl<factory_desc_t *, N_BAGS_MEDIUM> modifiable_table;
@@ -76,6 +80,13 @@ public:
 	 */
 	static void new_world();
 
+	/**
+	 * While a pool is set, find_random_construction_site() checks its
+	 * candidate sites in parallel; used during map creation. The chosen
+	 * site is the same as with a serial search.
+	 */
+	static void set_site_search_pool(task_pool_t *pool) { site_search_pool = pool; }
+
 	/// Creates a certain number of tourist attractions.
 	static void distribute_attractions(int max_number);
 
@@ -145,6 +156,9 @@ private:
 	 */
 	static koord3d find_random_construction_site(koord pos, int radius, koord size, factory_desc_t::site_t site, const building_desc_t *desc, bool ignore_climates, uint32 max_iterations);
 
+	/// checks one chunk of candidates of find_random_construction_site() (a task of the site search pool)
+	static void check_construction_sites_task(void *ptr, uint32 task);
+
 	/**
 	 * Checks if all factories in this factory tree can be rotated.
 	 * This method is called recursively on all potential suppliers.
@@ -602,7 +602,7 @@ bool way_builder_t::is_allowed_step( const grund_t *from, const grund_t *to, sin
 	const koord from_pos=from->get_pos().get_2d();
 	const koord to_pos=to->get_pos().get_2d();
 	const koord zv=to_pos-from_pos;
-	// fake empty elevated tiles
+	// fake empty elevated tiles (elevated ways are never searched in parallel)
 	static monorailboden_t to_dummy(koord3d::invalid, slope_t::flat);
 	static monorailboden_t from_dummy(koord3d::invalid, slope_t::flat);
 
@@ -1177,7 +1177,12 @@ bool way_builder_t::is_allowed_step( const grund_t *from, const grund_t *to, sin
 				// calculate costs
 				if(ok) {
 					// prefer existing rivers:
-					*costs = to->hat_weg(water_wt) ? 10 : 10+simrand(s.way_count_90_curve, "bool way_builder_t::is_allowed_step");
+					if(  to->hat_weg(water_wt)  ) {
+						*costs = 10;
+					}
+					else {
+						*costs = 10 + (random_stream ? random_stream->rand(s.way_count_90_curve) : simrand(s.way_count_90_curve, "bool way_builder_t::is_allowed_step"));
+					}
 					if(to->get_weg_hang()!=0  &&  !to_flat) {
 						*costs += s.way_count_slope * 10;
 					}
@@ -1622,7 +1627,7 @@ sint32 way_builder_t::intern_calc_route(const vector_tpl<koord3d> &start, const
 		route_t::INIT_NODES(welt->get_settings().get_max_route_steps(), welt->get_size());
 	}
 
-	static binary_heap_tpl <route_t::ANode *> queue;
+	static thread_local binary_heap_tpl <route_t::ANode *> queue;
 
 	// get exclusively a tile list
 	route_t::ANode *nodes;
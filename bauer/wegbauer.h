@@ -22,6 +22,7 @@ class player_t;
 class grund_t;
 class tool_selector_t;
 class strasse_t;
+class simrand_stream_t;
 
 
 /**
@@ -172,6 +173,9 @@ private:
 
 	bool route_reversed;
 
+	/// if set, used instead of simrand() for the random river costs
+	simrand_stream_t *random_stream = NULL;
+
 public:
 	/**
 	* This is the core routine for the way search
@@ -243,6 +247,9 @@ public:
 
 	void set_maximum(uint32 n) { maximum = n; }
 
+	/// for route searches which run in parallel (see task_pool_t)
+	void set_random_stream(simrand_stream_t *stream) { random_stream = stream; }
+
 	void set_overtaking_mode(overtaking_mode_t o) { overtaking_mode = o; }
 
 	void set_desc(const way_desc_t* way_desc) { desc = way_desc; }
@@ -812,6 +812,7 @@ void grund_t::set_halt(halthandle_t halt)
 		flags &= ~is_halt_flag;
 		flags |= dirty;
 	}
+	welt->update_free_area( pos.get_2d() );
 }
 
 
@@ -2131,6 +2132,7 @@ sint64 grund_t::neuen_weg_bauen(weg_t *weg, ribi_t::ribi ribi, player_t *player,
 
 		// may result in a crossing, but the wegebauer will recalc all images anyway
 		weg->calc_image();
+		welt->update_free_area( pos.get_2d() );
 	}
 	return cost;
 }
@@ -2194,6 +2196,7 @@ sint32 grund_t::weg_entfernen(waytype_t wegtyp, bool ribi_rem)
 
 		calc_image();
 		minimap_t::get_instance()->calc_map_pixel(get_pos().get_2d());
+		welt->update_free_area( pos.get_2d() );
 
 		return costs;
 	}
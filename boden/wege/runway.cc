@@ -90,6 +90,9 @@ void runway_t::rdwr(loadsave_t *file)
 	{
 		uint16 reserved_index = reserved.get_id();
 		file->rdwr_short(reserved_index);
-		reserved.set_id(reserved_index);
+		if (file->is_loading())
+		{
+			reserved.set_id(reserved_index);
+		}
 	}
 }
@@ -56,6 +56,35 @@ schiene_t::schiene_t(loadsave_t *file) : weg_t(track_wt)
 }
 
 
+schiene_t::~schiene_t()
+{
+	set_reserved( convoihandle_t() );
+}
+
+
+void schiene_t::set_reserved(convoihandle_t c)
+{
+	if(  reserved == c  ) {
+		return;
+	}
+	if(  reserved.is_bound()  ) {
+		reserved->remove_reserved_tile( this );
+	}
+	reserved = c;
+	if(  reserved.is_bound()  ) {
+		reserved->add_reserved_tile( this );
+	}
+}
+
+
+void schiene_t::register_loaded_reservation()
+{
+	if(  reserved.is_bound()  ) {
+		reserved->add_reserved_tile( this );
+	}
+}
+
+
 void schiene_t::cleanup(player_t *)
 {
 	// removes reservation
@@ -87,7 +116,7 @@ bool schiene_t::reserve(convoihandle_t c, ribi_t::ribi dir, reservation_type t,
 			// is already done, but show that this is reservable.
 			return true;
 		}
-		reserved = c;
+		set_reserved(c);
 		type = t;
 		direction = dir;
 
@@ -132,7 +161,7 @@ bool schiene_t::unreserve(convoihandle_t c)
 {
 	// is this tile reserved by us?
 	if(reserved.is_bound()  &&  reserved==c) {
-		reserved = convoihandle_t();
+		set_reserved(convoihandle_t());
 		if(schiene_t::show_reservations) {
 			set_flag( obj_t::dirty );
 		}
@@ -155,7 +184,7 @@ bool schiene_t::unreserve(vehicle_t*)
 		return true;
 	}
 //	if(!welt->lookup(get_pos())->suche_obj(v->get_typ())) {
-		reserved = convoihandle_t();
+		set_reserved(convoihandle_t());
 		if(schiene_t::show_reservations) {
 			set_flag( obj_t::dirty );
 		}
@@ -276,11 +305,16 @@ void schiene_t::rdwr(loadsave_t *file)
 			if (reserved.is_bound() && !is_type_rail_type(reserved->front()->get_waytype()))
 			{
 				// This is an invalid reservation - clear it.
+				set_reserved(convoihandle_t());
 				reserved_index = 0;
 			}
 		}
 		file->rdwr_short(reserved_index);
-		reserved.set_id(reserved_index);
+		if (file->is_loading())
+		{
+			// The convoys are not loaded yet, see register_loaded_reservation()
+			reserved.set_id(reserved_index);
+		}
 
 		uint8 t = (uint8)type;
 		file->rdwr_byte(t);
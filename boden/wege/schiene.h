@@ -40,6 +40,9 @@ protected:
 
 	bool is_type_rail_type(waytype_t wt) { return wt == track_wt || wt == monorail_wt || wt == maglev_wt || wt == tram_wt || wt == narrowgauge_wt; }
 
+	/// changes the reservation and the list of reserved tiles of the convoys
+	void set_reserved(convoihandle_t c);
+
 public:
 	static const way_desc_t *default_schiene;
 
@@ -52,6 +55,8 @@ public:
 
 	schiene_t();
 
+	virtual ~schiene_t();
+
 	/**
 	* true, if this rail can be reserved
 	*/
@@ -120,6 +125,12 @@ public:
 	*/
 	convoihandle_t get_reserved_convoi() const {return reserved;}
 
+	/**
+	 * Adds a reservation read from a savegame to the list of its convoy,
+	 * which was loaded after the ways.
+	 */
+	void register_loaded_reservation();
+
 	void rdwr(loadsave_t *file) OVERRIDE;
 
 	void rotate90() OVERRIDE;
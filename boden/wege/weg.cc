@@ -5,8 +5,10 @@
 
 #include <stdio.h>
 #include <tuple>
+#include <algorithm>
 
 #include "../../tpl/slist_tpl.h"
+#include "../../tpl/inthashtable_tpl.h"
 
 #include "weg.h"
 
@@ -34,6 +36,7 @@
 #include "../../obj/gebaeude.h" // for ::should_city_adopt_this
 #include "../../obj/pier.h"
 #include "../../utils/cbuffer_t.h"
+#include "../../dataobj/freelist.h"
 #include "../../dataobj/environment.h" // TILE_HEIGHT_STEP
 #include "../../dataobj/translator.h"
 #include "../../dataobj/loadsave.h"
@@ -63,6 +66,70 @@ pthread_mutex_t weg_t::private_car_route_map::route_map_mtx = PTHREAD_MUTEX_INIT
 vector_tpl <weg_t *> alle_wege;
 
 static slist_tpl<std::tuple<weg_t*, uint32, uint32>> pending_road_travel_time_updates;
+
+/**
+ * Ways by the month in which the monthly base wear will have brought them
+ * down to the renewal threshold; only these need a visit at month change.
+ */
+typedef inthashtable_tpl<uint32, vector_tpl<weg_t *>, N_BAGS_SMALL> wear_due_ways_t;
+static wear_due_ways_t wear_due_ways;
+
+way_stats_t weg_t::stats;
+
+
+uint32 way_stats_t::alloc()
+{
+	uint32 id;
+	if(  !free_ids.empty()  ) {
+		id = free_ids.pop_back();
+	}
+	else {
+		id = count++;
+		if(  (id & (BLOCK_SIZE - 1)) == 0  ) {
+			if(  (id >> BLOCK_BITS) >= MAX_BLOCKS  ) {
+				dbg->fatal( "way_stats_t::alloc()", "More than %u ways!", MAX_BLOCKS * BLOCK_SIZE );
+			}
+			blocks[id >> BLOCK_BITS] = new block_t;
+		}
+	}
+	for(  int month=0;  month<MAX_WAY_STAT_MONTHS;  month++  ) {
+		for(  int type=0;  type<MAX_WAY_STATISTICS;  type++  ) {
+			statistics(id, month, type) = 0;
+		}
+		for(  int type=0;  type<MAX_WAY_TRAVEL_TIMES;  type++  ) {
+			travel_times(id, month, type) = 0;
+		}
+	}
+	updated_month(id) = 0;
+	wear_due_month(id) = 0;
+	wear_due_index(id) = 0;
+	return id;
+}
+
+
+void way_stats_t::free(uint32 id)
+{
+	// zero, so that scans over all ids can ignore the unused ones
+	for(  int month=0;  month<MAX_WAY_STAT_MONTHS;  month++  ) {
+		for(  int type=0;  type<MAX_WAY_STATISTICS;  type++  ) {
+			statistics(id, month, type) = 0;
+		}
+	}
+	free_ids.append( id );
+}
+
+
+void way_stats_t::clear()
+{
+	for(  uint32 i = 0;  i < get_block_count();  i++  ) {
+		delete blocks[i];
+		blocks[i] = NULL;
+	}
+	count = 0;
+	free_ids.clear();
+}
+
+
 /**
  * Get list of all ways
  */
@@ -79,6 +146,8 @@ uint32 weg_t::get_all_ways_count()
 void weg_t::clear_list_of__ways()
 {
 	alle_wege.clear();
+	wear_due_ways.clear();
+	stats.clear();
 }
 
 
@@ -151,6 +220,13 @@ sint32 weg_t::get_max_speed(bool needs_electrification) const
 
 void weg_t::set_desc(const way_desc_t *b, bool from_saved_game)
 {
+	if(!from_saved_game)
+	{
+		// The months since the last update still wear the old way, and the
+		// wear capacity below is then counted from the current month.
+		update_month();
+	}
+
 	if(desc)
 	{
 		// Remove the old maintenance cost
@@ -338,6 +414,7 @@ void weg_t::set_desc(const way_desc_t *b, bool from_saved_game)
 			}
 		}
 	}
+	schedule_wear();
 }
 
 
@@ -348,12 +425,12 @@ void weg_t::init_statistics()
 {
 	for(  int type=0;  type<MAX_WAY_STATISTICS;  type++  ) {
 		for(  int month=0;  month<MAX_WAY_STAT_MONTHS;  month++  ) {
-			statistics[month][type] = 0;
+			stats.statistics(stats_id, month, type) = 0;
 		}
 	}
 	for(  int type=0;  type<MAX_WAY_TRAVEL_TIMES;  type++  ) {
 		for(  int month=0;  month<MAX_WAY_STAT_MONTHS;  month++  ) {
-			travel_times[month][type] = 0;
+			stats.travel_times(stats_id, month, type) = 0;
 		}
 	}
 	creation_month_year = welt->get_timeline_year_month();
@@ -370,6 +447,7 @@ void weg_t::init()
 	max_axle_load = 1000;
 	bridge_weight_limit = UINT32_MAX_VALUE;
 	desc = 0;
+	stats_id = stats.alloc();
 	init_statistics();
 	alle_wege.append(this);
 	flags = 0;
@@ -379,6 +457,7 @@ void weg_t::init()
 	degraded = false;
 	remaining_wear_capacity = 100000000;
 	replacement_way = NULL;
+	stats.updated_month(stats_id) = welt->get_current_month();
 #ifdef MULTI_THREAD
 	pthread_mutexattr_init(&mutex_attributes);
 	//int error = pthread_rwlockattr_init(&rwlock_attributes);
@@ -394,6 +473,18 @@ void weg_t::init()
 }
 
 
+void* weg_t::operator new(size_t s)
+{
+	return freelist_t::gimme_node(s);
+}
+
+
+void weg_t::operator delete(void* p, size_t s)
+{
+	freelist_t::putback_node(s, p);
+}
+
+
 weg_t::~weg_t()
 {
 	if (!welt->is_destroying())
@@ -405,6 +496,8 @@ weg_t::~weg_t()
 		//delete_all_routes_from_here();
 
 		alle_wege.remove(this);
+		unschedule_wear();
+		stats.free(stats_id);
 		player_t *player = get_owner();
 		if (player  &&  desc)
 		{
@@ -425,6 +518,11 @@ void weg_t::rdwr(loadsave_t *file)
 {
 	xml_tag_t t( file, "weg_t" );
 
+	if(  file->is_saving()  ) {
+		// the savegame has no month stamp
+		update_month();
+	}
+
 	// save owner
 	if(  file->is_version_atleast(99, 6)  ) {
 		sint8 spnum=get_owner_nr();
@@ -459,9 +557,9 @@ void weg_t::rdwr(loadsave_t *file)
 	{
 		for(uint32 month = 0; month < MAX_WAY_STAT_MONTHS; month++)
 		{
-			sint32 w = statistics[month][type];
+			sint32 w = stats.statistics(stats_id, month, type);
 			file->rdwr_long(w);
-			statistics[month][type] = (sint16)w;
+			stats.statistics(stats_id, month, type) = (sint16)w;
 		}
 	}
 
@@ -473,7 +571,7 @@ void weg_t::rdwr(loadsave_t *file)
 		{
 			for (uint32 month = 0; month < MAX_WAY_STAT_MONTHS; month++)
 			{
-				travel_times[month][type] = 0;
+				stats.travel_times(stats_id, month, type) = 0;
 			}
 		}
 	}
@@ -487,15 +585,15 @@ void weg_t::rdwr(loadsave_t *file)
 
 		for (uint32 month = 0; month < MAX_WAY_STAT_MONTHS; month++)
 		{
-			uint32 w = travel_times[month][WAY_TRAVEL_TIME_ACTUAL];
+			uint32 w = stats.travel_times(stats_id, month, WAY_TRAVEL_TIME_ACTUAL);
 
 			// Get the now-deprecated stopped vehicles count
 			file->rdwr_long(w);
 
-			travel_times[month][WAY_TRAVEL_TIME_IDEAL] = statistics[month][WAY_STAT_CONVOIS] * mul;
+			stats.travel_times(stats_id, month, WAY_TRAVEL_TIME_IDEAL) = stats.statistics(stats_id, month, WAY_STAT_CONVOIS) * mul;
 
 			// We'll estimate a stopped vehicle to take twice longer than usual to cross the tile
-			travel_times[month][WAY_TRAVEL_TIME_ACTUAL] = (statistics[month][WAY_STAT_CONVOIS] + (uint32)w) * mul;
+			stats.travel_times(stats_id, month, WAY_TRAVEL_TIME_ACTUAL) = (stats.statistics(stats_id, month, WAY_STAT_CONVOIS) + (uint32)w) * mul;
 		}
 	}
 
@@ -506,9 +604,9 @@ void weg_t::rdwr(loadsave_t *file)
 		{
 			for (uint32 month = 0; month < MAX_WAY_STAT_MONTHS; month++)
 			{
-				uint32 w = travel_times[month][type];
+				uint32 w = stats.travel_times(stats_id, month, type);
 				file->rdwr_long(w);
-				travel_times[month][type] = (uint32)w;
+				stats.travel_times(stats_id, month, type) = (uint32)w;
 			}
 		}
 	}
@@ -1149,22 +1247,230 @@ void weg_t::check_diagonal()
 /**
  * new month
  */
-void weg_t::new_month()
+uint32 weg_t::get_current_month()
+{
+	return welt->get_current_month();
+}
+
+
+uint32 weg_t::get_months_behind() const
 {
-	for (int type=0; type<MAX_WAY_STATISTICS; type++) {
-		for (int month=MAX_WAY_STAT_MONTHS-1; month>0; month--) {
-			statistics[month][type] = statistics[month-1][type];
+	const uint32 now = welt->get_current_month();
+	// the month may go back during map creation
+	return now > stats.updated_month(stats_id) ? now - stats.updated_month(stats_id) : 0;
+}
+
+
+void weg_t::roll_statistics(uint32 months)
+{
+	for(  int type=0;  type<MAX_WAY_STATISTICS;  type++  ) {
+		for(  int month=MAX_WAY_STAT_MONTHS-1;  month>=0;  month--  ) {
+			stats.statistics(stats_id, month, type) = (uint32)month >= months ? stats.statistics(stats_id, month-months, type) : 0;
+		}
+	}
+	for(  int type=0;  type<MAX_WAY_TRAVEL_TIMES;  type++  ) {
+		for(  int month=MAX_WAY_STAT_MONTHS-1;  month>=0;  month--  ) {
+			stats.travel_times(stats_id, month, type) = (uint32)month >= months ? stats.travel_times(stats_id, month-months, type) : 0;
 		}
-		statistics[0][type] = 0;
 	}
+}
+
 
-	for (int type=0; type<MAX_WAY_TRAVEL_TIMES; type++) {
-		for (int month=MAX_WAY_STAT_MONTHS-1; month>0; month--) {
-			travel_times[month][type] = travel_times[month-1][type];
+void weg_t::apply_base_wear(uint32 months)
+{
+	// This never reaches the renewal threshold, otherwise this way would
+	// have been due in new_month_all() already (see schedule_wear()).
+	const uint32 base_wear = desc ? desc->get_monthly_base_wear() : 0;
+	if(  months  &&  base_wear  &&  remaining_wear_capacity != UINT32_MAX_VALUE  &&  !(degraded  &&  remaining_wear_capacity <= base_wear)  ) {
+		const uint64 wear = (uint64)base_wear * months;
+		remaining_wear_capacity = wear < remaining_wear_capacity ? remaining_wear_capacity - (uint32)wear : 0;
+	}
+}
+
+
+void weg_t::update_month()
+{
+	const uint32 months = get_months_behind();
+	stats.updated_month(stats_id) = welt->get_current_month();
+	if(  months  ) {
+		roll_statistics( months );
+		apply_base_wear( months );
+	}
+}
+
+
+int weg_t::get_statistics(int type) const
+{
+	const uint32 behind = get_months_behind();
+	return behind <= WAY_STAT_LAST_MONTH ? stats.statistics(stats_id, WAY_STAT_LAST_MONTH - behind, type) : 0;
+}
+
+
+sint32 weg_t::get_max_statistics(int type)
+{
+	// get_statistics() for all ways at once
+	const uint32 now = welt->get_current_month();
+	sint32 max_value = 0;
+	for(  uint32 nr = 0;  nr < stats.get_block_count();  nr++  ) {
+		const way_stats_t::block_t *block = stats.get_block(nr);
+		const uint32 n = min( (uint32)way_stats_t::BLOCK_SIZE, stats.get_count() - (nr << way_stats_t::BLOCK_BITS) );
+		for(  uint32 i = 0;  i < n;  i++  ) {
+			const uint32 updated_month = block->updated_month[i];
+			const sint32 value = updated_month >= now ? block->statistics[WAY_STAT_LAST_MONTH][type][i] : (updated_month + 1 == now ? block->statistics[WAY_STAT_THIS_MONTH][type][i] : 0);
+			if(  value > max_value  ) {
+				max_value = value;
+			}
+		}
+	}
+	return max_value;
+}
+
+
+bool weg_t::is_disused() const
+{
+	const uint32 behind = get_months_behind();
+	for(  int month = WAY_STAT_THIS_MONTH;  month + behind <= WAY_STAT_LAST_MONTH;  month++  ) {
+		if(  stats.statistics(stats_id, month, WAY_STAT_CONVOIS) != 0  ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+uint32 weg_t::get_congestion_percentage() const
+{
+	const uint32 behind = get_months_behind();
+	uint32 combined_ideal = 0;
+	uint32 combined_actual = 0;
+	for(  int month = WAY_STAT_THIS_MONTH;  month + behind <= WAY_STAT_LAST_MONTH;  month++  ) {
+		combined_ideal += stats.travel_times(stats_id, month, WAY_TRAVEL_TIME_IDEAL);
+		combined_actual += stats.travel_times(stats_id, month, WAY_TRAVEL_TIME_ACTUAL);
+	}
+	if(combined_ideal == 0u) {
+		return 0u;
+	}
+	if(combined_actual <= combined_ideal) {
+		return 0u;
+	}
+	return (combined_actual * 100u / combined_ideal) - 100u;
+}
+
+
+uint32 weg_t::get_remaining_wear_capacity() const
+{
+	// same as update_month() would do
+	const uint32 months = get_months_behind();
+	const uint32 base_wear = desc ? desc->get_monthly_base_wear() : 0;
+	if(  months == 0  ||  !base_wear  ||  remaining_wear_capacity == UINT32_MAX_VALUE  ||  (degraded  &&  remaining_wear_capacity <= base_wear)  ) {
+		return remaining_wear_capacity;
+	}
+	const uint64 wear = (uint64)base_wear * months;
+	return wear < remaining_wear_capacity ? remaining_wear_capacity - (uint32)wear : 0;
+}
+
+
+void weg_t::unschedule_wear()
+{
+	uint32 &due_month = stats.wear_due_month(stats_id);
+	if(  due_month  ) {
+		const uint32 index = stats.wear_due_index(stats_id);
+		vector_tpl<weg_t *> *due = wear_due_ways.access( due_month );
+		assert( due  &&  (*due)[index] == this );
+		// move the last one into our place
+		weg_t *last = due->pop_back();
+		if(  last != this  ) {
+			(*due)[index] = last;
+			stats.wear_due_index(last->stats_id) = index;
+		}
+		if(  due->empty()  ) {
+			wear_due_ways.remove( due_month );
+		}
+		due_month = 0;
+	}
+}
+
+
+void weg_t::schedule_wear()
+{
+	uint32 due_month = 0;
+	const uint32 base_wear = desc ? desc->get_monthly_base_wear() : 0;
+	if(  base_wear  &&  remaining_wear_capacity != UINT32_MAX_VALUE  &&  !(degraded  &&  remaining_wear_capacity <= base_wear)  ) {
+		// first month in which the remaining capacity drops below the threshold (see wear_way())
+		const uint32 threshold = desc->get_wear_capacity() / welt->get_settings().get_way_degradation_fraction();
+		const uint64 months = remaining_wear_capacity >= threshold ? (remaining_wear_capacity - threshold) / base_wear + 1 : 1;
+		const uint64 due = (uint64)stats.updated_month(stats_id) + months;
+		due_month = due < UINT32_MAX_VALUE ? (uint32)due : 0;
+	}
+	// otherwise the base wear will never change anything here
+
+	if(  due_month == stats.wear_due_month(stats_id)  ) {
+		// the usual case when worn by vehicles
+		return;
+	}
+	unschedule_wear();
+	if(  due_month  ) {
+		wear_due_ways.put( due_month );
+		vector_tpl<weg_t *> *due = wear_due_ways.access( due_month );
+		stats.wear_due_month(stats_id) = due_month;
+		stats.wear_due_index(stats_id) = due->get_count();
+		due->append( this );
+	}
+}
+
+
+void weg_t::check_monthly_wear()
+{
+	// all months but the current one silently, the current one with the usual checks
+	const uint32 months = get_months_behind();
+	stats.updated_month(stats_id) = welt->get_current_month();
+	roll_statistics( months );
+	if(  months > 1  ) {
+		apply_base_wear( months - 1 );
+	}
+	wear_way( desc->get_monthly_base_wear() );
+}
+
+
+static bool compare_ways(const weg_t *a, const weg_t *b)
+{
+	const koord3d pa = a->get_pos(), pb = b->get_pos();
+	if(  pa.x != pb.x  ) {
+		return pa.x < pb.x;
+	}
+	if(  pa.y != pb.y  ) {
+		return pa.y < pb.y;
+	}
+	if(  pa.z != pb.z  ) {
+		return pa.z < pb.z;
+	}
+	return a->get_waytype() < b->get_waytype();
+}
+
+
+void weg_t::new_month_all()
+{
+	const uint32 now = welt->get_current_month();
+
+	vector_tpl<uint32> due_months;
+	FOR(wear_due_ways_t, const& i, wear_due_ways) {
+		if(  i.key <= now  ) {
+			due_months.append( i.key );
+		}
+	}
+	std::sort( due_months.begin(), due_months.end() );
+
+	FOR(vector_tpl<uint32>, const month, due_months) {
+		vector_tpl<weg_t *> due = wear_due_ways.remove( month );
+		// renewals cost money, hence the order must not depend on the table
+		std::sort( due.begin(), due.end(), compare_ways );
+		FOR(vector_tpl<weg_t *>, const w, due) {
+			stats.wear_due_month(w->stats_id) = 0;
+		}
+		FOR(vector_tpl<weg_t *>, const w, due) {
+			w->check_monthly_wear();
 		}
-		travel_times[0][type] = 0;
 	}
-	wear_way(desc->get_monthly_base_wear());
 }
 
 
@@ -1324,13 +1630,15 @@ uint32 weg_t::get_condition_percent() const
 	}
 	// Necessary to avoid overflow. Speed not important as this is for the UI.
 	// Running calculations should use fractions (e.g., "if(remaining_wear_capacity < desc->get_wear_capacity() / 6)").
-	const sint64 remaining_wear_capacity_percent = (sint64)remaining_wear_capacity  * 100ll;
+	// with the base wear of the months since the last update
+	const sint64 remaining_wear_capacity_percent = (sint64)get_remaining_wear_capacity()  * 100ll;
 	const sint64 intermediate_result = remaining_wear_capacity_percent / (sint64)desc->get_wear_capacity();
 	return (uint32)intermediate_result;
 }
 
 void weg_t::wear_way(uint32 wear)
 {
+	update_month();
 	if(!wear || remaining_wear_capacity == UINT32_MAX_VALUE)
 	{
 		// If ways are defined with UINT32_MAX_VALUE,
@@ -1357,6 +1665,7 @@ void weg_t::wear_way(uint32 wear)
 			degrade();
 		}
 	}
+	schedule_wear();
 }
 
 bool weg_t::renew()
@@ -1432,6 +1741,7 @@ bool weg_t::renew()
 
 void weg_t::degrade()
 {
+	update_month();
 	if(public_right_of_way)
 	{
 		// Do not degrade public rights of way, as these should remain passable.
@@ -1482,6 +1792,7 @@ void weg_t::degrade()
 			}
 		}
 	}
+	schedule_wear();
 }
 
 signal_t *weg_t::get_signal(ribi_t::ribi direction_of_travel) const
@@ -19,6 +19,7 @@
 #include "../../dataobj/koord3d.h"
 #include "../../tpl/minivec_tpl.h"
 #include "../../tpl/ordered_vector_tpl.h"
+#include "../../tpl/vector_tpl.h"
 #include "../../simskin.h"
 
 #ifdef MULTI_THREAD
@@ -33,7 +34,6 @@ class signal_t;
 class gebaeude_t;
 class stadt_t;
 class unordered_map;
-template <class T> class vector_tpl;
 
 
 // maximum number of months to store information
@@ -74,6 +74,70 @@ enum travel_times {
 
 
 
+/**
+ * Monthly statistics of all ways, kept apart from the way objects as
+ * structure of arrays indexed by weg_t::stats_id. book() from the moving
+ * vehicles only touches the densely packed counter in question, the way
+ * objects get smaller, and statistics over all ways are a linear scan.
+ *
+ * The arrays are allocated in blocks which never move, since route
+ * searches in other threads may read while ways are built.
+ * Ids of removed ways are reused.
+ */
+class way_stats_t
+{
+public:
+	enum {
+		BLOCK_BITS = 12,
+		BLOCK_SIZE = 1 << BLOCK_BITS,
+		MAX_BLOCKS = 1 << 14
+	};
+
+	struct block_t
+	{
+		sint16 statistics[MAX_WAY_STAT_MONTHS][MAX_WAY_STATISTICS][BLOCK_SIZE];
+		uint32 travel_times[MAX_WAY_STAT_MONTHS][MAX_WAY_TRAVEL_TIMES][BLOCK_SIZE];
+		/// see weg_t::update_month()
+		uint32 updated_month[BLOCK_SIZE];
+		/// see weg_t::schedule_wear()
+		uint32 wear_due_month[BLOCK_SIZE];
+		uint32 wear_due_index[BLOCK_SIZE];
+	};
+
+	way_stats_t() : count(0)
+	{
+		for(  uint32 i = 0;  i < MAX_BLOCKS;  i++  ) {
+			blocks[i] = NULL;
+		}
+	}
+	~way_stats_t() { clear(); }
+
+	/// @returns a new id with all values zero
+	uint32 alloc();
+	void free(uint32 id);
+	void clear();
+
+	/// number of ids, including the unused ones
+	uint32 get_count() const { return count; }
+
+	uint32 get_block_count() const { return (count + BLOCK_SIZE - 1) >> BLOCK_BITS; }
+	const block_t *get_block(uint32 nr) const { return blocks[nr]; }
+
+	sint16 &statistics(uint32 id, int month, int type) { return blocks[id >> BLOCK_BITS]->statistics[month][type][id & (BLOCK_SIZE - 1)]; }
+	sint16 statistics(uint32 id, int month, int type) const { return blocks[id >> BLOCK_BITS]->statistics[month][type][id & (BLOCK_SIZE - 1)]; }
+	uint32 &travel_times(uint32 id, int month, int type) { return blocks[id >> BLOCK_BITS]->travel_times[month][type][id & (BLOCK_SIZE - 1)]; }
+	uint32 travel_times(uint32 id, int month, int type) const { return blocks[id >> BLOCK_BITS]->travel_times[month][type][id & (BLOCK_SIZE - 1)]; }
+	uint32 &updated_month(uint32 id) { return blocks[id >> BLOCK_BITS]->updated_month[id & (BLOCK_SIZE - 1)]; }
+	uint32 updated_month(uint32 id) const { return blocks[id >> BLOCK_BITS]->updated_month[id & (BLOCK_SIZE - 1)]; }
+	uint32 &wear_due_month(uint32 id) { return blocks[id >> BLOCK_BITS]->wear_due_month[id & (BLOCK_SIZE - 1)]; }
+	uint32 &wear_due_index(uint32 id) { return blocks[id >> BLOCK_BITS]->wear_due_index[id & (BLOCK_SIZE - 1)]; }
+
+private:
+	block_t *blocks[MAX_BLOCKS];
+	uint32 count;
+	vector_tpl<uint32> free_ids;
+};
+
 
 /**
  * Ways is the base class for all traffic routes. (roads, track, runway etc.)
@@ -122,13 +186,14 @@ public:
 
 private:
 	/**
-	* array for statistical values
+	* statistical values of all ways
 	* MAX_WAY_STAT_MONTHS: [0] = actual value; [1] = last month value
 	* MAX_WAY_STATISTICS: see #define at top of file
 	*/
-	sint16 statistics[MAX_WAY_STAT_MONTHS][MAX_WAY_STATISTICS];
+	static way_stats_t stats;
 
-	uint32 travel_times[MAX_WAY_STAT_MONTHS][MAX_WAY_TRAVEL_TIMES];
+	/// index into stats
+	uint32 stats_id;
 
 
 	/**
@@ -210,6 +275,35 @@ private:
 	// Whether the way is in a degraded state.
 	bool degraded:1;
 
+	/* stats.updated_month is the month (karte_t::get_current_month()) up to
+	 * which the statistics have been rolled over and the monthly base wear
+	 * has been applied. Both are only brought up to date when the way is
+	 * touched, see update_month().
+	 *
+	 * stats.wear_due_month is the month in which the base wear will have
+	 * brought this way down to the renewal threshold (0 = never), and
+	 * stats.wear_due_index the index in that month's list. Only these ways
+	 * are visited by new_month_all().
+	 */
+
+	/// karte_t::get_current_month(), since simworld.h is not included here
+	static uint32 get_current_month();
+
+	/// Rolls over the statistics and applies the pending base wear
+	void update_month();
+	void roll_statistics(uint32 months);
+	void apply_base_wear(uint32 months);
+
+	/// Months the statistics are behind the current month
+	uint32 get_months_behind() const;
+
+	/// (Re)enters this way into the list of the month it needs a wear check
+	void schedule_wear();
+	void unschedule_wear();
+
+	/// Applies the monthly base wear and checks for renewal
+	void check_monthly_wear();
+
 
 protected:
 
@@ -486,20 +580,30 @@ public:
 	/**
 	* book statistics - is called very often and therefore inline
 	*/
-	void book(int amount, way_statistics type) { statistics[WAY_STAT_THIS_MONTH][type] += amount; }
+	void book(int amount, way_statistics type)
+	{
+		if(  stats.updated_month(stats_id) != get_current_month()  ) {
+			update_month();
+		}
+		stats.statistics(stats_id, WAY_STAT_THIS_MONTH, type) += amount;
+	}
 
 	/**
 	* return statistics value
 	* always returns last month's value
 	*/
-	int get_statistics(int type) const { return statistics[WAY_STAT_LAST_MONTH][type]; }
+	int get_statistics(int type) const;
 
-	bool is_disused() const { return statistics[WAY_STAT_LAST_MONTH][WAY_STAT_CONVOIS] == 0 && statistics[WAY_STAT_THIS_MONTH][WAY_STAT_CONVOIS] == 0; }
+	bool is_disused() const;
+
+	/// largest last month's value of all ways (a linear scan)
+	static sint32 get_max_statistics(int type);
 
 	/**
-	* new month
+	* new month: only the ways, whose condition needs checking, are visited;
+	* everything else is updated lazily
 	*/
-	void new_month();
+	static void new_month_all();
 
 	void check_diagonal();
 
@@ -549,7 +653,7 @@ public:
 	uint16 get_creation_month_year() const { return creation_month_year; }
 	uint16 get_last_renewal_monty_year() const { return last_renewal_month_year; }
 
-	uint32 get_remaining_wear_capacity() const { return remaining_wear_capacity; }
+	uint32 get_remaining_wear_capacity() const;
 	uint32 get_condition_percent() const;
 
 	/**
@@ -577,24 +681,20 @@ public:
 	//void increment_traffic_stopped_counter() { statistics[0][WAY_STAT_WAITING] ++; }
 	inline void update_travel_times(uint32 actual, uint32 ideal)
 	{
-		travel_times[WAY_STAT_THIS_MONTH][WAY_TRAVEL_TIME_ACTUAL] += actual;
-		travel_times[WAY_STAT_THIS_MONTH][WAY_TRAVEL_TIME_IDEAL] += ideal;
+		if(  stats.updated_month(stats_id) != get_current_month()  ) {
+			update_month();
+		}
+		stats.travel_times(stats_id, WAY_STAT_THIS_MONTH, WAY_TRAVEL_TIME_ACTUAL) += actual;
+		stats.travel_times(stats_id, WAY_STAT_THIS_MONTH, WAY_TRAVEL_TIME_IDEAL) += ideal;
 	}
 
 	//will return the % ratio of actual to ideal traversal times
-	inline uint32 get_congestion_percentage() const {
-		uint32 combined_ideal = travel_times[WAY_STAT_THIS_MONTH][WAY_TRAVEL_TIME_IDEAL] + travel_times[WAY_STAT_LAST_MONTH][WAY_TRAVEL_TIME_IDEAL];
-		if(combined_ideal == 0u) {
-			return 0u;
-		}
-		uint32 combined_actual = travel_times[WAY_STAT_THIS_MONTH][WAY_TRAVEL_TIME_ACTUAL] + travel_times[WAY_STAT_LAST_MONTH][WAY_TRAVEL_TIME_ACTUAL];
-		if(combined_actual <= combined_ideal) {
-			return 0u;
-		}
-		return (combined_actual * 100u / combined_ideal) - 100u;
-	}
+	uint32 get_congestion_percentage() const;
 
 	uint8 get_map_idx(const koord3d &next_tile) const;
+
+	void* operator new(size_t s);
+	void  operator delete(void* p, size_t s);
 };
 
 
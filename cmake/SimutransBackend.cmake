@@ -14,6 +14,8 @@ if (WIN32)
 endif ()
 
 list(APPEND AVAILABLE_BACKENDS "none")
+# no display, but full graphics drawn into memory (for render benchmarks)
+list(APPEND AVAILABLE_BACKENDS "offscreen")
 
 string(REGEX MATCH "^[^;][^;]*" FIRST_BACKEND "${AVAILABLE_BACKENDS}")
 set(SIMUTRANS_BACKEND "${FIRST_BACKEND}" CACHE STRING "Graphics backend")
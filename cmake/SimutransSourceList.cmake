@@ -27,8 +27,10 @@ target_sources(simutrans-extended PRIVATE
 	convoy.cc
 	dataobj/crossing_logic.cc
 	dataobj/environment.cc
+	dataobj/free_area_index.cc
 	dataobj/freelist.cc
 	dataobj/gameinfo.cc
+	dataobj/halt_grid.cc
 	dataobj/height_map_loader.cc
 	dataobj/koord3d.cc
 	dataobj/koord.cc
@@ -215,6 +217,7 @@ target_sources(simutrans-extended PRIVATE
 	gui/sound_frame.cc
 	gui/sprachen.cc
 	gui/station_building_select.cc
+	gui/step_profiler_frame.cc
 	gui/themeselector.cc
 	gui/times_history_container.cc
 	gui/tool_selector.cc
@@ -358,6 +361,8 @@ target_sources(simutrans-extended PRIVATE
 	utils/simrandom.cc
 	utils/simstring.cc
 	utils/simthread.cc
+	utils/step_profiler.cc
+	utils/task_pool.cc
 	vehicle/movingobj.cc
 	vehicle/pedestrian.cc
 	vehicle/simroadtraffic.cc
@@ -600,6 +600,49 @@ sint16 potential_convoy_t::get_current_friction()
 
 /******************************************************************************/
 
+void convoy_physics_memo_t::check_dependencies(const float32e8_t &a, const float32e8_t &b, const float32e8_t &c, const float32e8_t &d, sint32 i)
+{
+	if (depends_on[0] != a || depends_on[1] != b || depends_on[2] != c || depends_on[3] != d || depends_on_int != i)
+	{
+		depends_on[0] = a;
+		depends_on[1] = b;
+		depends_on[2] = c;
+		depends_on[3] = d;
+		depends_on_int = i;
+		used = 0;
+	}
+}
+
+/******************************************************************************/
+
+sint32 lazy_convoy_t::calc_max_speed(const weight_summary_t &weight)
+{
+	validate_vehicle_summary();
+	validate_adverse_summary();
+	max_speed_memo.check_dependencies(adverse.fr, adverse.cf, get_starting_force(), get_continuous_power(), vehicle_summary.max_speed);
+	sint32 max_speed;
+	if (!max_speed_memo.get(weight, 0, max_speed))
+	{
+		max_speed = convoy_t::calc_max_speed(weight);
+		max_speed_memo.put(weight, 0, max_speed);
+	}
+	return max_speed;
+}
+
+sint32 lazy_convoy_t::calc_min_braking_distance(const settings_t &settings, const weight_summary_t &weight, sint32 speed)
+{
+	braking_distance_memo.check_dependencies(adverse.fr, get_braking_force(), float32e8_t::zero, float32e8_t::zero, settings.get_meters_per_tile());
+	sint32 steps;
+	if (!braking_distance_memo.get(weight, speed, steps))
+	{
+		steps = convoy_t::calc_min_braking_distance(settings, weight, speed);
+		braking_distance_memo.put(weight, speed, steps);
+	}
+	return steps;
+}
+
+/******************************************************************************/
+
 // Bernd Gabriel, Dec, 25 2009
 sint16 existing_convoy_t::get_current_friction()
 {
@@ -204,6 +204,11 @@ struct weight_summary_t
 	void add_weight(sint32 kgs, sint32 sin_alpha);
 
 	void add_vehicle(const vehicle_t &v);
+
+	inline bool operator == (const weight_summary_t &value) const
+	{
+		return weight == value.weight && weight_sin == value.weight_sin && weight_cos == value.weight_cos;
+	}
 };
 
 /******************************************************************************/
@@ -376,6 +381,68 @@ enum convoy_detail_e
 	cd_braking_force    = 0x40,
 };
 
+/******************************************************************************/
+
+#define CONVOY_PHYSICS_MEMO_SIZE (4) // must be a power of 2
+
+/**
+ * A tiny direct mapped memo of results of convoy_t::calc_max_speed() or convoy_t::calc_min_braking_distance().
+ * These are called over and over again with the same weight from the convoy's sync step, the signalling
+ * lookahead and the GUI. Entries are keyed by the exact weight summary (and speed), thus a hit returns
+ * exactly the value a recalculation would return.
+ * All entries are dropped as soon as any of the convoy properties they depend on has changed.
+ */
+class convoy_physics_memo_t
+{
+private:
+	struct entry_t
+	{
+		weight_summary_t weight;
+		sint32 speed;
+		sint32 value;
+	};
+	entry_t entries[CONVOY_PHYSICS_MEMO_SIZE];
+	uint8 used; // bit i is set, if entries[i] is valid.
+
+	// the convoy properties the entries have been calculated with.
+	float32e8_t depends_on[4];
+	sint32 depends_on_int;
+
+	static inline uint32 get_index(const weight_summary_t &weight, sint32 speed)
+	{
+		return ((uint32)weight.weight ^ ((uint32)speed * 0x9E3779B1u)) % CONVOY_PHYSICS_MEMO_SIZE;
+	}
+public:
+	convoy_physics_memo_t() : used(0), depends_on_int(0) {}
+
+	/**
+	 * Drop all entries, if any of the given convoy properties differs from the ones the entries have been calculated with.
+	 */
+	void check_dependencies(const float32e8_t &a, const float32e8_t &b, const float32e8_t &c, const float32e8_t &d, sint32 i);
+
+	inline bool get(const weight_summary_t &weight, sint32 speed, sint32 &value) const
+	{
+		const uint32 index = get_index(weight, speed);
+		const entry_t &entry = entries[index];
+		if ((used & (1 << index)) && entry.speed == speed && entry.weight == weight)
+		{
+			value = entry.value;
+			return true;
+		}
+		return false;
+	}
+
+	inline void put(const weight_summary_t &weight, sint32 speed, sint32 value)
+	{
+		const uint32 index = get_index(weight, speed);
+		entry_t &entry = entries[index];
+		entry.weight = weight;
+		entry.speed = speed;
+		entry.value = value;
+		used |= 1 << index;
+	}
+};
+
 class lazy_convoy_t /*abstract*/ : public convoy_t
 {
 private:
@@ -383,6 +450,8 @@ private:
 	float32e8_t starting_force;   // in N, calculated in convoy_t::get_starting_force()
 	float32e8_t braking_force;      // in N, calculated in convoy_t::get_brake_force()
 	float32e8_t continuous_power; // in W, calculated in convoy_t::get_continuous_power()
+	convoy_physics_memo_t max_speed_memo;
+	convoy_physics_memo_t braking_distance_memo;
 protected:
 	int is_valid; // OR combined enum convoy_detail_e values.
 	// decendents implement the update methods.
@@ -526,12 +595,11 @@ public:
 		is_valid = 0;
 	}
 
-	sint32 calc_max_speed(const weight_summary_t &weight)
-	{
-		validate_vehicle_summary();
-		validate_adverse_summary();
-		return convoy_t::calc_max_speed(weight);
-	}
+	// memoized versions of the convoy_t methods.
+	sint32 calc_max_speed(const weight_summary_t &weight);
+
+	using convoy_t::calc_min_braking_distance;
+	sint32 calc_min_braking_distance(const class settings_t &settings, const weight_summary_t &weight, sint32 speed);
 
 	sint32 calc_max_weight(sint32 sin_alpha)
 	{
@@ -101,6 +101,7 @@ bool env_t::player_finance_display_account = true;
 
 // the following initialisation is not important; set values in init()!
 std::string env_t::objfilename;
+bool env_t::ground_texture_cache = false;
 bool env_t::night_shift;
 bool env_t::hide_with_transparency;
 bool env_t::hide_trees;
@@ -159,6 +160,8 @@ bool env_t::cities_ignore_height = false;
 bool env_t::second_open_closes_win;
 bool env_t::remember_window_positions;
 uint8 env_t::num_threads;
+uint32 env_t::script_ops_per_call;
+uint32 env_t::script_step_budget_ms;
 bool env_t::draw_earth_border;
 bool env_t::draw_outside_tile;
 
@@ -288,6 +291,9 @@ void env_t::init()
 	num_threads = 1;
 #endif
 
+	script_ops_per_call = 1000;
+	script_step_budget_ms = 0;
+
 	sound_distance_scaling = 10;
 
 	show_tooltips = true;
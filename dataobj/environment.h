@@ -53,6 +53,9 @@ public:
 	/// name of the directory to the pak-set
 	static std::string objfilename;
 
+	/// if true, the generated ground textures are kept in a cache file in the user directory
+	static bool ground_texture_cache;
+
 	/// this the the preferred GUI theme at startup
 	static plainstring default_theme;
 
@@ -426,6 +429,12 @@ public:
 	/// number of threads to use (if MULTI_THREAD defined)
 	static uint8 num_threads;
 
+	/// number of opcodes a script may run in one call, before it is suspended (or fails if it cannot)
+	static uint32 script_ops_per_call;
+
+	/// milliseconds a script which ran out of opcodes may continue in one step; 0: once per step
+	static uint32 script_step_budget_ms;
+
 	/// false to quit the programs
 	static bool quit_simutrans;
 
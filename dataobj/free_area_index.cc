@@ -0,0 +1,168 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <string.h>
+
+#include "free_area_index.h"
+#include "../simworld.h"
+#include "../boden/grund.h"
+
+
+/// the height which square_is_free() compares: the highest corner
+static inline sint16 get_max_height(const grund_t *gr)
+{
+	return gr->get_hoehe() + slope_t::max_diff( gr->get_grund_hang() );
+}
+
+
+/// the lowest set bit of a non-zero mask
+static inline uint8 lowest_bit(uint64 mask)
+{
+	return (uint8)hammingWeight( (mask & (~mask + 1)) - 1 );
+}
+
+
+void free_area_index_t::init(const karte_t *welt)
+{
+	clear();
+	size_x = welt->get_size().x;
+	size_y = welt->get_size().y;
+	blocks_x = (size_x + 7) >> BLOCK_BITS;
+	const uint32 count = (uint32)blocks_x * (uint32)((size_y + 7) >> BLOCK_BITS);
+	blocks = new block_t[count];
+	memset( blocks, 0, sizeof(block_t) * count );
+
+	for(  sint16 y = 0;  y < size_y;  y++  ) {
+		for(  sint16 x = 0;  x < size_x;  x++  ) {
+			calc_tile( welt, x, y );
+		}
+	}
+}
+
+
+void free_area_index_t::clear()
+{
+	delete [] blocks;
+	blocks = NULL;
+	size_x = size_y = blocks_x = 0;
+}
+
+
+void free_area_index_t::calc_tile(const karte_t *welt, sint16 x, sint16 y)
+{
+	block_t &b = blocks[ (y >> BLOCK_BITS) * blocks_x + (x >> BLOCK_BITS) ];
+	const uint64 bit = (uint64)1 << (((y & 7) << 3) | (x & 7));
+
+	b.not_natural &= ~bit;
+	b.near_water &= ~bit;
+	b.same_height_east &= ~bit;
+	b.same_height_south &= ~bit;
+	for(  int c = 0;  c < MAX_CLIMATES;  c++  ) {
+		b.climate[c] &= ~bit;
+	}
+
+	const koord k(x, y);
+	b.climate[ welt->get_climate( k ) ] |= bit;
+	for(  int i = 0;  i < 8;  i++  ) {
+		const koord n = k + koord::neighbours[i];
+		if(  welt->is_within_limits( n )  &&  welt->get_climate( n ) == water_climate  ) {
+			b.near_water |= bit;
+			break;
+		}
+	}
+
+	const grund_t *gr = welt->lookup_kartenboden( x, y );
+	if(  gr == NULL  ) {
+		b.not_natural |= bit;
+		return;
+	}
+	if(  !gr->ist_natur()  ) {
+		b.not_natural |= bit;
+	}
+	// the last column and row are never compared with their outside neighbours
+	const sint16 height = get_max_height( gr );
+	const grund_t *east = x + 1 < size_x ? welt->lookup_kartenboden( x + 1, y ) : NULL;
+	if(  x + 1 >= size_x  ||  (east  &&  get_max_height( east ) == height)  ) {
+		b.same_height_east |= bit;
+	}
+	const grund_t *south = y + 1 < size_y ? welt->lookup_kartenboden( x, y + 1 ) : NULL;
+	if(  y + 1 >= size_y  ||  (south  &&  get_max_height( south ) == height)  ) {
+		b.same_height_south |= bit;
+	}
+}
+
+
+void free_area_index_t::update(const karte_t *welt, koord k)
+{
+	if(  blocks == NULL  ) {
+		return;
+	}
+	// the neighbours compare their height with k and look for water on k
+	for(  sint16 y = k.y - 1;  y <= k.y + 1;  y++  ) {
+		for(  sint16 x = k.x - 1;  x <= k.x + 1;  x++  ) {
+			if(  x >= 0  &&  y >= 0  &&  x < size_x  &&  y < size_y  ) {
+				calc_tile( welt, x, y );
+			}
+		}
+	}
+}
+
+
+uint8 free_area_index_t::find_blocking_tiles(koord pos, sint16 w, sint16 h, climate_bits cl, koord found[2]) const
+{
+	const sint16 x_last = pos.x + w - 1;
+	const sint16 y_last = pos.y + h - 1;
+
+	for(  sint16 by = pos.y >> BLOCK_BITS;  by <= y_last >> BLOCK_BITS;  by++  ) {
+		const sint16 y0 = max( pos.y, by << BLOCK_BITS );
+		const sint16 y1 = min( y_last, (by << BLOCK_BITS) + 7 );
+		// one bit in the lowest column of every row in the rectangle
+		uint64 rows = 0;
+		for(  sint16 y = y0;  y <= y1;  y++  ) {
+			rows |= (uint64)1 << ((y & 7) << 3);
+		}
+		// no height comparison with the row below the rectangle
+		const uint64 rows_south = y1 == y_last ? rows & ~((uint64)1 << ((y1 & 7) << 3)) : rows;
+
+		for(  sint16 bx = pos.x >> BLOCK_BITS;  bx <= x_last >> BLOCK_BITS;  bx++  ) {
+			const sint16 x0 = max( pos.x, bx << BLOCK_BITS );
+			const sint16 x1 = min( x_last, (bx << BLOCK_BITS) + 7 );
+			const uint64 columns = (0xFFu << (x0 & 7)) & (0xFFu >> (7 - (x1 & 7)));
+			const uint64 mask = rows * columns;
+			const block_t &b = blocks[ by * blocks_x + bx ];
+
+			uint64 climate_ok = (cl & water_climate_bit) ? b.near_water : 0;
+			for(  int c = 0;  c < MAX_CLIMATES;  c++  ) {
+				if(  cl & (1 << c)  ) {
+					climate_ok |= b.climate[c];
+				}
+			}
+			uint64 blocking = (b.not_natural | ~climate_ok) & mask;
+			if(  blocking  ) {
+				const uint8 i = lowest_bit( blocking );
+				found[0] = koord( (bx << BLOCK_BITS) + (i & 7), (by << BLOCK_BITS) + (i >> 3) );
+				return 1;
+			}
+
+			// no height comparison with the column right of the rectangle
+			const uint64 columns_east = x1 == x_last ? columns & ~((uint64)1 << (x1 & 7)) : columns;
+			blocking = ~b.same_height_east & rows * columns_east;
+			if(  blocking  ) {
+				const uint8 i = lowest_bit( blocking );
+				found[0] = koord( (bx << BLOCK_BITS) + (i & 7), (by << BLOCK_BITS) + (i >> 3) );
+				found[1] = found[0] + koord( 1, 0 );
+				return 2;
+			}
+			blocking = ~b.same_height_south & rows_south * columns;
+			if(  blocking  ) {
+				const uint8 i = lowest_bit( blocking );
+				found[0] = koord( (bx << BLOCK_BITS) + (i & 7), (by << BLOCK_BITS) + (i >> 3) );
+				found[1] = found[0] + koord( 0, 1 );
+				return 2;
+			}
+		}
+	}
+	return 0;
+}
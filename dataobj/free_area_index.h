@@ -0,0 +1,77 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef DATAOBJ_FREE_AREA_INDEX_H
+#define DATAOBJ_FREE_AREA_INDEX_H
+
+
+#include "koord.h"
+#include "../simtypes.h"
+
+class karte_t;
+
+
+/**
+ * Bitmaps of the map tiles, for karte_t::square_is_free(): which tiles are
+ * no natural ground, which climate they have, which are next to water and
+ * which have the same height as their eastern and southern neighbours.
+ * The map is divided into blocks of 8x8 tiles with one bit per tile in a
+ * uint64, so a rectangle of a few blocks is tested with a few masks instead
+ * of a loop over all its tiles.
+ *
+ * The index only gives hints: square_is_free() checks the tiles it returns
+ * against the map, so the results are the same when the index is outdated
+ * (just slower). It is updated when grounds, ways, halts or the climate of
+ * a tile change.
+ *
+ * Only to be changed from the main thread.
+ */
+class free_area_index_t
+{
+public:
+	free_area_index_t() : blocks(NULL), size_x(0), size_y(0), blocks_x(0) {}
+	~free_area_index_t() { clear(); }
+
+	/// (re)builds the index for the whole map
+	void init(const karte_t *welt);
+
+	void clear();
+
+	/// @returns true if the index was built for a map of this size
+	bool is_built_for(koord size) const { return blocks  &&  size.x == size_x  &&  size.y == size_y; }
+
+	/// recalculates the tile k and its neighbours
+	void update(const karte_t *welt, koord k);
+
+	/**
+	 * Looks for a tile in the rectangle of w x h tiles at pos, which is no
+	 * natural ground, has no climate of cl (or no water next to it, if cl
+	 * includes water), or whose height differs from a neighbour inside the
+	 * rectangle. The rectangle must be on the map.
+	 * @return the number of tiles written to found: 0 if there is none, 2 for
+	 * both tiles of a height step, otherwise 1.
+	 */
+	uint8 find_blocking_tiles(koord pos, sint16 w, sint16 h, climate_bits cl, koord found[2]) const;
+
+private:
+	enum { BLOCK_BITS = 3 };
+
+	struct block_t
+	{
+		uint64 not_natural;
+		uint64 near_water;
+		uint64 same_height_east;
+		uint64 same_height_south;
+		uint64 climate[MAX_CLIMATES];
+	};
+
+	void calc_tile(const karte_t *welt, sint16 x, sint16 y);
+
+	block_t *blocks;
+	sint16 size_x, size_y;
+	sint16 blocks_x;
+};
+
+#endif
@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <string.h>
 
 #include "../simtypes.h"
 #include "../simmem.h"
@@ -44,32 +45,124 @@ static nodelist_node_t *chunk_list = NULL;
 // (the few request for larger ones are satisfied with xmalloc otherwise)
 
 
-// for 64 bit, set this to 128
-#define MAX_LIST_INDEX (128)
+// large enough for ways, private cars and pedestrians on 64 bit
+#define MAX_LIST_INDEX (256)
 
-// list for nodes size 8...64
+// list for nodes size 8...256
 #define NUM_LIST ((MAX_LIST_INDEX/4)+1)
 
-static nodelist_node_t *all_lists[NUM_LIST] = {
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
-	NULL
-};
+static nodelist_node_t *all_lists[NUM_LIST];
 
 
 // to have this working, we need chunks at least the size of a pointer
 const size_t min_size = sizeof(void *);
 
 
+#ifdef MULTI_THREAD
+/* Each thread keeps some free nodes of every size for itself, so most
+ * requests do not need the mutex. Nodes are moved between a thread and the
+ * common lists in batches of LOCAL_BATCH. When a thread ends (like the pak
+ * loaders, the minimap threads or the map creation tasks), its cached nodes
+ * go back to the common lists.
+ */
+#define LOCAL_BATCH (32)
+
+// free_all_nodes() increments this, which invalidates the caches of all threads
+static uint32 cache_generation = 1;
+
+struct local_cache_t
+{
+	nodelist_node_t *list[NUM_LIST];
+	uint16 count[NUM_LIST];
+	uint32 generation;
+
+	~local_cache_t();
+};
+
+static thread_local local_cache_t local_cache;
+
+
+static local_cache_t &get_local_cache()
+{
+	local_cache_t &cache = local_cache;
+	if(  cache.generation != cache_generation  ) {
+		memset( cache.list, 0, sizeof(cache.list) );
+		memset( cache.count, 0, sizeof(cache.count) );
+		cache.generation = cache_generation;
+	}
+	return cache;
+}
+
+
+local_cache_t::~local_cache_t()
+{
+	if(  generation != cache_generation  ) {
+		// never used or the nodes were freed already
+		return;
+	}
+	int error = pthread_mutex_lock( &freelist_mutex );
+	assert(error == 0);
+	for(  int i=0;  i<NUM_LIST;  i++  ) {
+		if(  list[i] == NULL  ) {
+			continue;
+		}
+		nodelist_node_t *last = list[i];
+		while(  last->next  ) {
+			last = last->next;
+		}
+		last->next = all_lists[i];
+		all_lists[i] = list[i];
+		list[i] = NULL;
+		count[i] = 0;
+	}
+	error = pthread_mutex_unlock( &freelist_mutex );
+	assert(error == 0);
+	(void)error;
+}
+#endif
+
+
+// adds a new chunk of nodes to the list; must hold the mutex
+static void add_chunk(nodelist_node_t **list, size_t size)
+{
+	int num_elements = 32764/(int)size;
+	char* p = (char*)xmalloc(num_elements * size + sizeof(p));
+
+#ifdef USE_VALGRIND_MEMCHECK
+	// tell valgrind that we still cannot access the pool p
+	VALGRIND_MAKE_MEM_NOACCESS(p, num_elements * size + sizeof(p));
+#endif
+
+	// put the memory into the chunklist for free it
+	nodelist_node_t *chunk = (nodelist_node_t *)p;
+
+#ifdef USE_VALGRIND_MEMCHECK
+	// tell valgrind that we reserved space for one nodelist_node_t
+	VALGRIND_CREATE_MEMPOOL(chunk, 0, false);
+	VALGRIND_MEMPOOL_ALLOC(chunk, chunk, sizeof(*chunk));
+	VALGRIND_MAKE_MEM_UNDEFINED(chunk, sizeof(*chunk));
+#endif
+
+	chunk->next = chunk_list;
+	chunk_list = chunk;
+	p += sizeof(p);
+	// then enter nodes into nodelist
+	for(  int i=0;  i<num_elements;  i++  ) {
+		nodelist_node_t *tmp = (nodelist_node_t *)(p+i*size);
+#ifdef USE_VALGRIND_MEMCHECK
+		// tell valgrind that we reserved space for one nodelist_node_t
+		VALGRIND_CREATE_MEMPOOL(tmp, 0, false);
+		VALGRIND_MEMPOOL_ALLOC(tmp, tmp, sizeof(*tmp));
+		VALGRIND_MAKE_MEM_UNDEFINED(tmp, sizeof(*tmp));
+#endif
+		tmp->next = *list;
+		*list = tmp;
+	}
+}
+
+
 void *freelist_t::gimme_node(size_t size)
 {
-	nodelist_node_t ** list = NULL;
 	if(  size == 0  ) {
 		return NULL;
 	}
@@ -83,21 +176,11 @@ void *freelist_t::gimme_node(size_t size)
 	size = (size+3)>>2;
 	size <<= 2;
 
-#ifdef MULTI_THREAD
-	int error = pthread_mutex_lock( &freelist_mutex );
-	assert(error == 0);
-	(void)error;
-#endif
-
 	// hold return value
 	nodelist_node_t *tmp;
 	if(  size > MAX_LIST_INDEX  ) {
 		// too large: just use malloc anyway
 		tmp = (nodelist_node_t *)xmalloc(size);
-#ifdef MULTI_THREAD
-		error = pthread_mutex_unlock( &freelist_mutex );
-		assert(error == 0);
-#endif
 #ifdef DEBUG_FREELIST
 		tmp->magic = 0xAA;
 		tmp->free = 0;
@@ -106,44 +189,36 @@ void *freelist_t::gimme_node(size_t size)
 		return tmp;
 	}
 
-
-	list = &(all_lists[size/4]);
-	// need new memory?
+#ifdef MULTI_THREAD
+	local_cache_t &cache = get_local_cache();
+	nodelist_node_t **list = &(cache.list[size/4]);
 	if(  *list == NULL  ) {
-		int num_elements = 32764/(int)size;
-		char* p = (char*)xmalloc(num_elements * size + sizeof(p));
-
-#ifdef USE_VALGRIND_MEMCHECK
-		// tell valgrind that we still cannot access the pool p
-		VALGRIND_MAKE_MEM_NOACCESS(p, num_elements * size + sizeof(p));
-#endif
-
-		// put the memory into the chunklist for free it
-		nodelist_node_t *chunk = (nodelist_node_t *)p;
-
-#ifdef USE_VALGRIND_MEMCHECK
-		// tell valgrind that we reserved space for one nodelist_node_t
-		VALGRIND_CREATE_MEMPOOL(chunk, 0, false);
-		VALGRIND_MEMPOOL_ALLOC(chunk, chunk, sizeof(*chunk));
-		VALGRIND_MAKE_MEM_UNDEFINED(chunk, sizeof(*chunk));
-#endif
-
-		chunk->next = chunk_list;
-		chunk_list = chunk;
-		p += sizeof(p);
-		// then enter nodes into nodelist
-		for(  int i=0;  i<num_elements;  i++  ) {
-			nodelist_node_t *tmp = (nodelist_node_t *)(p+i*size);
-#ifdef USE_VALGRIND_MEMCHECK
-			// tell valgrind that we reserved space for one nodelist_node_t
-			VALGRIND_CREATE_MEMPOOL(tmp, 0, false);
-			VALGRIND_MEMPOOL_ALLOC(tmp, tmp, sizeof(*tmp));
-			VALGRIND_MAKE_MEM_UNDEFINED(tmp, sizeof(*tmp));
-#endif
+		// fetch a batch from the common list
+		int error = pthread_mutex_lock( &freelist_mutex );
+		assert(error == 0);
+		nodelist_node_t **global_list = &(all_lists[size/4]);
+		while(  cache.count[size/4] < LOCAL_BATCH  ) {
+			if(  *global_list == NULL  ) {
+				add_chunk( global_list, size );
+			}
+			tmp = *global_list;
+			*global_list = tmp->next;
 			tmp->next = *list;
 			*list = tmp;
+			cache.count[size/4]++;
 		}
+		error = pthread_mutex_unlock( &freelist_mutex );
+		assert(error == 0);
+		(void)error;
+	}
+	cache.count[size/4]--;
+#else
+	nodelist_node_t **list = &(all_lists[size/4]);
+	// need new memory?
+	if(  *list == NULL  ) {
+		add_chunk( list, size );
 	}
+#endif
 
 	// return first node of list
 	tmp = *list;
@@ -155,11 +230,6 @@ void *freelist_t::gimme_node(size_t size)
 	VALGRIND_MAKE_MEM_UNDEFINED(tmp, size);
 #endif
 
-#ifdef MULTI_THREAD
-	error = pthread_mutex_unlock( &freelist_mutex );
-	assert(error == 0);
-#endif
-
 #ifdef DEBUG_FREELIST
 	tmp->magic = 0x5555;
 	tmp->free = 0;
@@ -171,7 +241,6 @@ void *freelist_t::gimme_node(size_t size)
 
 void freelist_t::putback_node( size_t size, void *p )
 {
-	nodelist_node_t ** list = NULL;
 	if(  size==0  ||  p==NULL  ) {
 		return;
 	}
@@ -185,24 +254,11 @@ void freelist_t::putback_node( size_t size, void *p )
 	size = ((size+3)>>2);
 	size <<= 2;
 
-#ifdef MULTI_THREAD
-	int error = pthread_mutex_lock( &freelist_mutex );
-	assert(error == 0);
-	(void)error;
-#endif
-
 	if(  size > MAX_LIST_INDEX  ) {
 		free(p);
-#ifdef MULTI_THREAD
-		int error = pthread_mutex_unlock( &freelist_mutex );
-		assert(error == 0);
-		(void)error;
-#endif
 		return;
 	}
 
-	list = &(all_lists[size/4]);
-
 #ifdef USE_VALGRIND_MEMCHECK
 	// tell valgrind that we keep access to a nodelist_node_t within the memory chunk
 	VALGRIND_MEMPOOL_CHANGE(p, p, p, sizeof(nodelist_node_t));
@@ -217,12 +273,32 @@ void freelist_t::putback_node( size_t size, void *p )
 	assert(  tmp->magic == 0x5555  &&  tmp->free == 0  &&  tmp->size == size/4  );
 	tmp->free = 1;
 #endif
-	tmp->next = *list;
-	*list = tmp;
 
 #ifdef MULTI_THREAD
-	error = pthread_mutex_unlock( &freelist_mutex );
-	assert(error == 0);
+	local_cache_t &cache = get_local_cache();
+	nodelist_node_t **list = &(cache.list[size/4]);
+	tmp->next = *list;
+	*list = tmp;
+	if(  ++cache.count[size/4] >= 2*LOCAL_BATCH  ) {
+		// return a batch to the common list
+		int error = pthread_mutex_lock( &freelist_mutex );
+		assert(error == 0);
+		nodelist_node_t **global_list = &(all_lists[size/4]);
+		for(  int i=0;  i<LOCAL_BATCH;  i++  ) {
+			tmp = *list;
+			*list = tmp->next;
+			tmp->next = *global_list;
+			*global_list = tmp;
+		}
+		cache.count[size/4] -= LOCAL_BATCH;
+		error = pthread_mutex_unlock( &freelist_mutex );
+		assert(error == 0);
+		(void)error;
+	}
+#else
+	nodelist_node_t **list = &(all_lists[size/4]);
+	tmp->next = *list;
+	*list = tmp;
 #endif
 }
 
@@ -246,5 +322,8 @@ void freelist_t::free_all_nodes()
 	for( int i=0;  i<NUM_LIST;  i++  ) {
 		all_lists[i] = nullptr;
 	}
+#ifdef MULTI_THREAD
+	cache_generation++;
+#endif
 	printf("freelist_t::free_all_nodes(): ok\n");
 }
@@ -12,7 +12,10 @@
 
 /**
  * Helper class to organize small memory objects i.e. nodes for linked lists
- * and such.
+ * and such, and the frequent map objects like trees and ways.
+ * Sizes up to 256 bytes are pooled, larger ones use malloc.
+ * With MULTI_THREAD every thread caches free nodes, so it can be used from
+ * the worker threads without much contention.
  */
 class freelist_t
 {
@@ -0,0 +1,114 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "halt_grid.h"
+#include "../simplan.h"
+
+
+void halt_grid_t::add(koord pos, halthandle_t halt)
+{
+	const uint32 key = get_key( pos.x >> CELL_BITS, pos.y >> CELL_BITS );
+	cell_t *cell = cells.access( key );
+	if(  cell == NULL  ) {
+		cells.put( key );
+		cell = cells.access( key );
+	}
+	entry_t e;
+	e.pos = pos;
+	e.halt = halt;
+	cell->append( e );
+}
+
+
+void halt_grid_t::remove(koord pos, halthandle_t halt)
+{
+	cell_t *cell = cells.access( get_key( pos.x >> CELL_BITS, pos.y >> CELL_BITS ) );
+	if(  cell  ) {
+		for(  uint32 i = 0;  i < cell->get_count();  i++  ) {
+			if(  (*cell)[i].pos == pos  &&  (*cell)[i].halt == halt  ) {
+				cell->remove_at( i, false );
+				return;
+			}
+		}
+	}
+}
+
+
+bool halt_grid_t::get_distance(koord pos, halthandle_t halt, uint16 radius, uint16 &distance) const
+{
+	// a tile in the square is at most 2*radius away (koord_distance),
+	// and so is the closest tile of a halt which covers pos
+	const sint32 search = 2 * radius;
+	bool covered = false;
+	uint32 best = UINT32_MAX_VALUE;
+	const sint16 x0 = max( 0, pos.x - search ) >> CELL_BITS, x1 = (pos.x + search) >> CELL_BITS;
+	const sint16 y0 = max( 0, pos.y - search ) >> CELL_BITS, y1 = (pos.y + search) >> CELL_BITS;
+	for(  sint16 cy = y0;  cy <= y1;  cy++  ) {
+		for(  sint16 cx = x0;  cx <= x1;  cx++  ) {
+			// get() returns an empty cell if there is none
+			FOR( cell_t, const& e, cells.get( get_key( cx, cy ) ) ) {
+				if(  e.halt == halt  ) {
+					covered |= is_covered( e.pos, pos, radius );
+					const uint32 d = koord_distance( e.pos, pos );
+					if(  d < best  ) {
+						best = d;
+					}
+				}
+			}
+		}
+	}
+	if(  covered  ) {
+		distance = (uint16)best;
+	}
+	return covered;
+}
+
+
+void halt_grid_t::get_halts(koord pos, uint16 radius, vector_tpl<nearby_halt_t> &halts) const
+{
+	// see get_distance() for the size of the search
+	const sint32 search = 2 * radius;
+	const uint32 first = halts.get_count();
+	vector_tpl<bool> covered;
+	const sint16 x0 = max( 0, pos.x - search ) >> CELL_BITS, x1 = (pos.x + search) >> CELL_BITS;
+	const sint16 y0 = max( 0, pos.y - search ) >> CELL_BITS, y1 = (pos.y + search) >> CELL_BITS;
+	for(  sint16 cy = y0;  cy <= y1;  cy++  ) {
+		for(  sint16 cx = x0;  cx <= x1;  cx++  ) {
+			FOR( cell_t, const& e, cells.get( get_key( cx, cy ) ) ) {
+				if(  !e.halt.is_bound()  ) {
+					continue;
+				}
+				const uint32 d = koord_distance( e.pos, pos );
+				uint32 i = first;
+				while(  i < halts.get_count()  &&  halts[i].halt != e.halt  ) {
+					i++;
+				}
+				if(  i == halts.get_count()  ) {
+					nearby_halt_t nh;
+					nh.halt = e.halt;
+					nh.distance = (uint8)min( d, 255 );
+					halts.append( nh );
+					covered.append( false );
+				}
+				else if(  d < halts[i].distance  ) {
+					halts[i].distance = (uint8)d;
+				}
+				if(  is_covered( e.pos, pos, radius )  ) {
+					covered[i - first] = true;
+				}
+			}
+		}
+	}
+	// keep only the halts covering pos, in their order
+	uint32 n = first;
+	for(  uint32 i = first;  i < halts.get_count();  i++  ) {
+		if(  covered[i - first]  ) {
+			halts[n++] = halts[i];
+		}
+	}
+	while(  halts.get_count() > n  ) {
+		halts.pop_back();
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef DATAOBJ_HALT_GRID_H
+#define DATAOBJ_HALT_GRID_H
+
+
+#include "koord.h"
+#include "../halthandle_t.h"
+#include "../tpl/inthashtable_tpl.h"
+#include "../tpl/vector_tpl.h"
+
+struct nearby_halt_t;
+
+
+/**
+ * Coarse spatial index of the tiles of all halts, for radius queries
+ * without sweeping the map tile by tile. The map is divided into cells of
+ * 2^CELL_BITS x 2^CELL_BITS tiles; only cells which ever contained a halt
+ * tile use memory. A halt with several grounds on one position is entered
+ * once per ground, like in its tile list.
+ *
+ * A halt covers a tile if one of its tiles is within the square of the
+ * radius around it, like the station coverage. The distances reported are
+ * koord_distance() to the closest tile of the halt, like in the halt lists
+ * of the tiles.
+ * Only to be changed from the main thread.
+ */
+class halt_grid_t
+{
+public:
+	enum { CELL_BITS = 3 };
+
+	void add(koord pos, halthandle_t halt);
+
+	/// removes one entry of halt at pos
+	void remove(koord pos, halthandle_t halt);
+
+	void clear() { cells.clear(); }
+
+	/**
+	 * @return true if halt covers pos with the given radius; then distance is
+	 * set to the koord_distance() from pos to the closest tile of halt.
+	 */
+	bool get_distance(koord pos, halthandle_t halt, uint16 radius, uint16 &distance) const;
+
+	/**
+	 * Appends every halt which covers pos with the given radius to halts,
+	 * each once and with the koord_distance() of its closest tile.
+	 */
+	void get_halts(koord pos, uint16 radius, vector_tpl<nearby_halt_t> &halts) const;
+
+private:
+	struct entry_t {
+		koord pos;
+		halthandle_t halt;
+	};
+	typedef vector_tpl<entry_t> cell_t;
+
+	static bool is_covered(koord tile, koord pos, uint16 radius) { return abs( tile.x - pos.x ) <= radius  &&  abs( tile.y - pos.y ) <= radius; }
+
+	static uint32 get_key(sint16 cell_x, sint16 cell_y) { return ((uint32)(uint16)cell_x << 16) | (uint16)cell_y; }
+
+	inthashtable_tpl<uint32, cell_t, N_BAGS_LARGE> cells;
+};
+
+#endif
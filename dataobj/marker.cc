@@ -9,7 +9,7 @@
 #include "../boden/grund.h"
 #include "marker.h"
 
-marker_t marker_t::the_instance;
+thread_local marker_t marker_t::the_instance;
 marker_t* marker_t::markers;
 
 void marker_t::init(int world_size_x, int world_size_y)
@@ -44,8 +44,8 @@ class marker_t {
 	 */
 	void init(int world_size_x, int world_size_y);
 
-	/// the instance (single threaded only)
-	static marker_t the_instance;
+	/// the instance for threads without a marker index, one per thread
+	static thread_local marker_t the_instance;
 
 public:
 
@@ -138,7 +138,7 @@ static uint8 type_to_pri[256]=
 static void dl_free(obj_t** p, uint8 size)
 {
 	assert(size > 1);
-	if (size <= 16) {
+	if (size <= 32) {
 		freelist_t::putback_node(sizeof(*p) * size, p);
 	}
 	else {
@@ -151,7 +151,7 @@ static obj_t** dl_alloc(uint8 size)
 {
 	assert(size > 1);
 	obj_t** p;
-	if (size <= 16) {
+	if (size <= 32) {
 		p = static_cast<obj_t**>(freelist_t::gimme_node(sizeof(*p) * size ));
 	}
 	else {
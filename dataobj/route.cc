@@ -49,6 +49,7 @@ bool route_t::suspend_private_car_routing = false;
 void route_t::append(const route_t *r)
 {
 	assert(r != NULL);
+	revision++;
 	const uint32 hops = r->get_count()-1;
 	route.resize(hops+1+route.get_count());
 
@@ -66,10 +67,12 @@ void route_t::append(const route_t *r)
 void route_t::insert(koord3d k)
 {
 	route.insert_at(0,k);
+	revision++;
 }
 
 
 void route_t::remove_koord_from(uint32 i) {
+	revision++;
 	while(  i+1 < get_count()  ) {
 		route.pop_back();
 	}
@@ -77,6 +80,7 @@ void route_t::remove_koord_from(uint32 i) {
 
 void route_t::remove_koord_to(uint32 i)
 {
+	revision++;
 	for(uint32 c = 0; c < i; c++)
 	{
 		route.remove_at(0);
@@ -89,6 +93,7 @@ void route_t::remove_koord_to(uint32 i)
  */
 bool route_t::append_straight_route(karte_t *welt, koord3d dest )
 {
+	revision++;
 	const koord ziel=dest.get_2d();
 
 	if(  !welt->is_within_limits(ziel)  ) {
@@ -181,6 +186,7 @@ void route_t::RELEASE_NODES(uint8 nodes_index)
 bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdriver, const uint32 max_khm, uint8 start_dir, uint32 axle_load, sint32 max_tile_len, uint32 total_weight, uint32 max_depth, bool is_tall, find_route_flags flags)
 {
 	bool ok = false;
+	revision++;
 
 	// check for existing koordinates
 	const grund_t* g = welt->lookup(start);
@@ -1274,6 +1280,7 @@ void route_t::postprocess_water_route(karte_t *welt)
  route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d start, const koord3d ziel, test_driver_t* const tdriver, const sint32 max_khm, const uint32 axle_load, bool is_tall, sint32 max_len, const sint64 max_cost, const uint32 convoy_weight, koord3d avoid_tile, uint8 direction, find_route_flags flags)
 {
 	route.clear();
+	revision++;
 	const uint32 distance = shortest_distance(start.get_2d(), ziel.get_2d()) * 600;
 	if(tdriver->get_waytype() == water_wt && distance > (uint32)welt->get_settings().get_max_route_steps())
 	{
@@ -1412,6 +1419,7 @@ void route_t::rdwr(loadsave_t *file)
 	if(file->is_loading()) {
 		koord3d k;
 		route.clear();
+		revision++;
 		route.resize(max_n+2);
 		for(sint32 i=0;  i<=max_n;  i++ ) {
 			k.rdwr(file);
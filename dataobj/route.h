@@ -53,6 +53,9 @@ protected:
 	uint32 max_axle_load;
 	uint32 max_convoy_weight;
 
+	// increased whenever the tiles of the route change
+	uint32 revision;
+
 	void postprocess_water_route(karte_t *welt);
 
 	static inline uint32 calc_distance( const koord3d &p1, const koord3d &target )
@@ -63,7 +66,7 @@ protected:
 public:
 
 	// Constructor: set axle load and convoy weight to maximum possible value
-	route_t() : max_axle_load(0xFFFFFFFFl), max_convoy_weight(0xFFFFFFFFl) {};
+	route_t() : max_axle_load(0xFFFFFFFFl), max_convoy_weight(0xFFFFFFFFl), revision(0) {};
 
 
 	/**
@@ -102,7 +105,13 @@ public:
 
 	uint32 get_max_axle_load() const { return max_axle_load; }
 
-	void rotate90( sint16 y_size ) { route.rotate90( y_size ); }
+	void rotate90( sint16 y_size ) { route.rotate90( y_size ); revision++; }
+
+	/**
+	 * Changes with every change of the tiles, so the users of a route
+	 * can tell whether it is still the one they have seen before.
+	 */
+	uint32 get_revision() const { return revision; }
 
 
 	bool is_contained(const koord3d &k) const { return route.is_contained(k); }
@@ -135,12 +144,12 @@ public:
 	/**
 	 * Appends position @p k.
 	 */
-	inline void append(koord3d k) { route.append(k); }
+	inline void append(koord3d k) { route.append(k); revision++; }
 
 	/**
 	 * removes all tiles from the route
 	 */
-	void clear() { route.clear(); }
+	void clear() { route.clear(); revision++; }
 
 	/**
 	 * Removes all tiles at indices >@p i.
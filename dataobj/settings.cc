@@ -2086,6 +2086,8 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 	env_t::fps                         = contents.get_int_clamped( "frames_per_second",              env_t::fps,                       env_t::min_fps, env_t::max_fps );
 	env_t::ff_fps                      = contents.get_int_clamped( "fast_forward_frames_per_second", env_t::ff_fps,                    env_t::min_fps, env_t::max_fps );
 	env_t::num_threads                 = contents.get_int_clamped( "threads",                        env_t::num_threads,               1, MAX_THREADS );
+	env_t::script_ops_per_call         = contents.get_int_clamped( "script_ops_per_call",            env_t::script_ops_per_call,       100, INT_MAX );
+	env_t::script_step_budget_ms       = contents.get_int_clamped( "script_step_budget",             env_t::script_step_budget_ms,     0, 1000 );
 	env_t::simple_drawing_default      = contents.get_int_clamped( "simple_drawing_tile_size",       env_t::simple_drawing_default,    2, 256 );
 	env_t::simple_drawing_fast_forward = contents.get_int( "simple_drawing_fast_forward", env_t::simple_drawing_fast_forward ) != 0;
 	env_t::visualize_schedule          = contents.get_int( "visualize_schedule",          env_t::visualize_schedule ) != 0;
@@ -3181,6 +3183,7 @@ void settings_t::parse_simuconf( tabfile_t& simuconf, sint16& disp_width, sint16
 
 	// Default pak file path
 	objfilename = ltrim(contents.get_string("pak_file_path", "" ) );
+	env_t::ground_texture_cache = contents.get_int("ground_texture_cache", env_t::ground_texture_cache) != 0;
 
 	// FluidSynth MIDI parameters
 	if(  *contents.get("soundfont_filename")  ) {
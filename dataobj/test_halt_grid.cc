@@ -0,0 +1,68 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+/*
+ * Unit test for halt_grid_t: coverage is a square, the reported distance
+ * is koord_distance() to the closest tile.
+ * Do NOT link this into simutrans!  This is a unit test!
+ */
+#include <stdio.h>
+
+#include "halt_grid.h"
+#include "../simplan.h"
+
+// This is a hack, but it's worth it.  The templates need logging in order to link.
+#include "../simdebug.cc"
+#include "../utils/dumb-log.cc"
+#include "../simmem.cc"
+#include "freelist.cc"
+#include "halt_grid.cc"
+
+static int failures = 0;
+
+static void check(bool ok, const char *what)
+{
+	if(  !ok  ) {
+		fprintf( stderr, "FAILED: %s\n", what );
+		failures++;
+	}
+}
+
+int main()
+{
+	// no halt is dereferenced, only the handles are compared
+	static char dummy[2];
+	halthandle_t::init( 16 );
+	halthandle_t corner( (haltestelle_t *)&dummy[0] );
+	halthandle_t outside( (haltestelle_t *)&dummy[1] );
+
+	const uint16 r = 5;
+	const koord pos( 20, 20 );
+	halt_grid_t grid;
+	grid.add( pos + koord( r, r ), corner );
+	grid.add( pos + koord( r + 1, 0 ), outside );
+
+	uint16 distance = 0;
+	check( grid.get_distance( pos, corner, r, distance ), "halt at (r,r) covers the tile" );
+	check( distance == 2 * r, "distance of the halt at (r,r)" );
+	check( !grid.get_distance( pos, outside, r, distance ), "halt at (r+1,0) does not cover the tile" );
+
+	vector_tpl<nearby_halt_t> halts;
+	grid.get_halts( pos, r, halts );
+	check( halts.get_count() == 1  &&  halts[0].halt == corner, "get_halts() finds only the halt at (r,r)" );
+	check( halts.get_count() == 1  &&  halts[0].distance == 2 * r, "get_halts() distance of the halt at (r,r)" );
+
+	// a closer tile outside the square changes the distance, not the coverage
+	grid.add( pos + koord( r + 1, -1 ), corner );
+	check( grid.get_distance( pos, corner, r, distance )  &&  distance == r + 2, "closest tile outside the square" );
+
+	grid.remove( pos + koord( r, r ), corner );
+	check( !grid.get_distance( pos, corner, r, distance ), "removed tile does not cover the tile" );
+
+	if(  failures == 0  ) {
+		printf( "halt_grid_t: all tests passed\n" );
+	}
+	return failures;
+}
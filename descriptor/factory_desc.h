@@ -57,6 +57,9 @@ private:
 
 	weighted_vector_tpl<uint16> field_class_indices;
 
+	// field class desc under construction, only used while reading old (0x8001) field groups
+	field_class_desc_t *incomplete_field_class_desc;
+
 public:
 	// fills the array, is only called once during successfully_loaded() after resolve xrefs
 	void init_field_class_indices()
@@ -4,6 +4,9 @@
  */
 
 #include <stdio.h>
+#include <string.h>
+#include <string>
+#include <zlib.h>
 
 #include "../simdebug.h"
 #include "../simworld.h"
@@ -12,10 +15,23 @@
 #include "spezial_obj_tpl.h"
 #include "ground_desc.h"
 #include "../dataobj/environment.h"
+#include "../network/checksum.h"
+#include "../network/pakset_info.h"
+#include "../sys/simsys.h"
+#include "../tpl/vector_tpl.h"
+
+#ifdef MULTI_THREAD
+#include "../utils/simthread.h"
+#endif
 
 //const int totalslopes_single = 16;
 const int totalslopes = 81;
 
+// increase this, whenever the way the ground tiles are calculated changes
+#define GROUND_CACHE_VERSION (1)
+#define GROUND_CACHE_MAGIC "Simutrans-Extended ground texture cache\n"
+#define GROUND_CACHE_BYTE_ORDER (0x01020304)
+
 
 /****************************************************************************************************
 * some functions for manipulations/blending images
@@ -37,7 +53,6 @@ static image_t* create_textured_tile(const image_t* image_lightmap, const image_
 {
 	if(  image_lightmap == NULL  ) {
 		image_t *image_dest = image_t::create_single_pixel();
-		image_dest->register_image();
 		return image_dest;
 	}
 
@@ -90,7 +105,7 @@ static image_t* create_textured_tile(const image_t* image_lightmap, const image_
 	(void)image_texture;
 	(void)binary;
 #endif
-	image_dest->register_image();
+	// image_dest not registered
 	return image_dest;
 }
 
@@ -256,7 +271,6 @@ static image_t* create_alpha_tile(const image_t* image_lightmap, slope_t::type s
 {
 	if(  image_lightmap == NULL  ||  image_alphamap == NULL  ||  image_alphamap->get_pic()->w < 2  ) {
 		image_t *image_dest = image_t::create_single_pixel();
-		image_dest->register_image();
 		return image_dest;
 	}
 	assert( image_alphamap->get_pic()->w == image_alphamap->get_pic()->h);
@@ -377,7 +391,7 @@ static image_t* create_alpha_tile(const image_t* image_lightmap, slope_t::type s
 		} while(  *dest++ != 0  );
 	}
 
-	image_dest->register_image();
+	// image_dest not registered
 	return image_dest;
 }
 
@@ -538,6 +552,260 @@ image_id alpha_image[totalslopes];
 image_id alpha_corners_image[totalslopes * 15];
 image_id alpha_water_image[totalslopes * 15];
 
+
+/* One generated ground tile. The pixels of all tiles are calculated in
+ * parallel (or read from the cache), but the tiles are registered strictly
+ * in the order they were requested, so all image ids stay the same.
+ */
+struct ground_tile_t
+{
+	const image_t *lightmap;
+	const image_t *source; ///< texture or alpha map
+	slope_t::type slope;   ///< only used for alpha tiles
+	bool alpha;
+	bool binary;
+	image_id *id;          ///< receives the image id after registration, may be NULL
+	image_t *image;
+};
+
+
+static void add_textured_tile(vector_tpl<ground_tile_t> &tiles, const image_t *lightmap, const image_t *texture, bool binary = false, image_id *id = NULL)
+{
+	ground_tile_t tile = { lightmap, texture, 0, false, binary, id, NULL };
+	tiles.append(tile);
+}
+
+
+static void add_alpha_tile(vector_tpl<ground_tile_t> &tiles, const image_t *lightmap, slope_t::type slope, const image_t *alphamap, image_id *id)
+{
+	ground_tile_t tile = { lightmap, alphamap, slope, true, false, id, NULL };
+	tiles.append(tile);
+}
+
+
+static void calc_ground_tile(ground_tile_t &tile)
+{
+	if(  tile.alpha  ) {
+		tile.image = create_alpha_tile(tile.lightmap, tile.slope, tile.source);
+	}
+	else {
+		tile.image = create_textured_tile(tile.lightmap, tile.source, tile.binary);
+	}
+}
+
+
+#ifdef MULTI_THREAD
+struct calc_ground_tiles_param_t
+{
+	vector_tpl<ground_tile_t> *tiles;
+	uint32 first;
+	uint32 step;
+};
+
+
+static void *calc_ground_tiles_thread(void *ptr)
+{
+	const calc_ground_tiles_param_t *param = (const calc_ground_tiles_param_t *)ptr;
+	for(  uint32 i = param->first;  i < param->tiles->get_count();  i += param->step  ) {
+		calc_ground_tile((*param->tiles)[i]);
+	}
+	return NULL;
+}
+#endif
+
+
+// the tiles do not depend on each other, so every thread takes every n-th tile
+static void calc_ground_tiles(vector_tpl<ground_tile_t> &tiles)
+{
+#ifdef MULTI_THREAD
+	const uint32 num_threads = min(max(1, env_t::num_threads), tiles.get_count());
+	if(  num_threads > 1  ) {
+		calc_ground_tiles_param_t *params = new calc_ground_tiles_param_t[num_threads];
+		pthread_t *threads = new pthread_t[num_threads];
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+		uint32 started = 1;
+		for(  uint32 t = 0;  t < num_threads;  t++  ) {
+			params[t].tiles = &tiles;
+			params[t].first = t;
+			params[t].step = num_threads;
+		}
+		while(  started < num_threads  &&  pthread_create(&threads[started], &attr, calc_ground_tiles_thread, (void *)&params[started]) == 0  ) {
+			started++;
+		}
+		pthread_attr_destroy(&attr);
+
+		// the main thread does the first share, and also the share of any thread that could not be started
+		for(  uint32 t = started;  t < num_threads;  t++  ) {
+			calc_ground_tiles_thread(&params[t]);
+		}
+		calc_ground_tiles_thread(&params[0]);
+
+		for(  uint32 t = 1;  t < started;  t++  ) {
+			pthread_join(threads[t], NULL);
+		}
+		delete [] threads;
+		delete [] params;
+		return;
+	}
+#endif
+	FOR(vector_tpl<ground_tile_t>, &tile, tiles) {
+		calc_ground_tile(tile);
+	}
+}
+
+
+static void input_image(checksum_t &stamp, const image_t *image)
+{
+	if(  image == NULL  ) {
+		stamp.input((uint32)0);
+		return;
+	}
+	stamp.input((uint32)image->len);
+	stamp.input((sint32)image->x);
+	stamp.input((sint32)image->y);
+	stamp.input((sint32)image->w);
+	stamp.input((sint32)image->h);
+	stamp.input((uint32)adler32(0L, (const Bytef *)image->data, image->len * sizeof(PIXVAL)));
+}
+
+
+/* The generated tiles only depend on the pakset and on a few pakset settings.
+ * The ground images themselves are not part of the pakset checksum, so they
+ * are hashed as well.
+ */
+static void calc_ground_cache_stamp(checksum_t &stamp, uint32 count)
+{
+	stamp.input((uint32)GROUND_CACHE_VERSION);
+	stamp.input((uint32)COLOUR_DEPTH);
+	stamp.input(pakset_info_t::get_pakset_checksum().get_str(20));
+	stamp.input((sint32)TILE_HEIGHT_STEP);
+	stamp.input(ground_desc_t::double_grounds);
+	stamp.input(ground_desc_t::water_animation_stages);
+	stamp.input(count);
+	for(  uint16 i = 0;  i < totalslopes;  i++  ) {
+		input_image(stamp, light_map->get_image_ptr(i));
+	}
+	for(  uint16 i = 0;  i <= MAX_CLIMATES;  i++  ) {
+		input_image(stamp, boden_texture->get_image_ptr(i));
+	}
+	for(  uint16 i = 0;  i < 15;  i++  ) {
+		input_image(stamp, transition_slope_texture->get_image_ptr(i));
+		input_image(stamp, transition_water_texture->get_image_ptr(i));
+	}
+	for(  uint16 stage = 0;  stage < ground_desc_t::water_animation_stages;  stage++  ) {
+		input_image(stamp, ground_desc_t::sea->get_image_ptr(0, stage));
+	}
+	stamp.finish();
+}
+
+
+static std::string get_ground_cache_name()
+{
+	return std::string(env_t::user_dir) + "cache/ground_textures.cache";
+}
+
+
+// the cache is never shared between machines, so the data is kept in native byte order
+static bool read_ground_cache(const checksum_t &stamp, vector_tpl<ground_tile_t> &tiles)
+{
+	const std::string cache_name = get_ground_cache_name();
+	FILE *const fp = dr_fopen(cache_name.c_str(), "rb");
+	if(  !fp  ) {
+		return false;
+	}
+
+	char magic[sizeof(GROUND_CACHE_MAGIC)];
+	char cached_stamp[41];
+	uint32 byte_order = 0;
+	if(  fread(magic, sizeof(magic), 1, fp) != 1  ||  memcmp(magic, GROUND_CACHE_MAGIC, sizeof(magic)) != 0
+		||  fread(&byte_order, sizeof(byte_order), 1, fp) != 1  ||  byte_order != GROUND_CACHE_BYTE_ORDER
+		||  fread(cached_stamp, 40, 1, fp) != 1  ) {
+		dbg->warning("read_ground_cache()", "'%s' is not a ground texture cache", cache_name.c_str());
+		fclose(fp);
+		return false;
+	}
+	cached_stamp[40] = 0;
+	if(  strcmp(cached_stamp, stamp.get_str(20)) != 0  ) {
+		DBG_MESSAGE("read_ground_cache()", "'%s' is outdated", cache_name.c_str());
+		fclose(fp);
+		return false;
+	}
+
+	bool ok = true;
+	FOR(vector_tpl<ground_tile_t>, &tile, tiles) {
+		sint32 header[5];
+		uint8 zoomable;
+		if(  fread(header, sizeof(header), 1, fp) != 1  ||  fread(&zoomable, 1, 1, fp) != 1  ||  header[0] <= 0  ) {
+			ok = false;
+			break;
+		}
+		tile.image = new image_t(header[0]);
+		tile.image->x = header[1];
+		tile.image->y = header[2];
+		tile.image->w = header[3];
+		tile.image->h = header[4];
+		tile.image->zoomable = zoomable;
+		if(  fread(tile.image->data, sizeof(PIXVAL), tile.image->len, fp) != tile.image->len  ) {
+			ok = false;
+			break;
+		}
+	}
+	fclose(fp);
+
+	if(  !ok  ) {
+		dbg->warning("read_ground_cache()", "'%s' is truncated", cache_name.c_str());
+		FOR(vector_tpl<ground_tile_t>, &tile, tiles) {
+			delete tile.image;
+			tile.image = NULL;
+		}
+		return false;
+	}
+	DBG_MESSAGE("read_ground_cache()", "read %u ground tiles from '%s'", tiles.get_count(), cache_name.c_str());
+	return true;
+}
+
+
+static void write_ground_cache(const checksum_t &stamp, const vector_tpl<ground_tile_t> &tiles)
+{
+	dr_mkdir((std::string(env_t::user_dir) + "cache").c_str());
+
+	// write to a temporary file first, so an interrupted write never leaves a broken cache
+	const std::string cache_name = get_ground_cache_name();
+	const std::string tmp_name = cache_name + ".tmp";
+	FILE *const fp = dr_fopen(tmp_name.c_str(), "wb");
+	if(  !fp  ) {
+		dbg->warning("write_ground_cache()", "cannot write '%s'", tmp_name.c_str());
+		return;
+	}
+
+	const uint32 byte_order = GROUND_CACHE_BYTE_ORDER;
+	fwrite(GROUND_CACHE_MAGIC, sizeof(GROUND_CACHE_MAGIC), 1, fp);
+	fwrite(&byte_order, sizeof(byte_order), 1, fp);
+	fwrite(stamp.get_str(20), 40, 1, fp);
+	FOR(vector_tpl<ground_tile_t>, const& tile, tiles) {
+		const image_t *image = tile.image;
+		const sint32 header[5] = { (sint32)image->len, image->x, image->y, image->w, image->h };
+		fwrite(header, sizeof(header), 1, fp);
+		fwrite(&image->zoomable, 1, 1, fp);
+		fwrite(image->data, sizeof(PIXVAL), image->len, fp);
+	}
+	bool ok = ferror(fp) == 0;
+	fclose(fp);
+
+	if(  ok  ) {
+		dr_remove(cache_name.c_str());
+		ok = dr_rename(tmp_name.c_str(), cache_name.c_str()) == 0;
+	}
+	if(  !ok  ) {
+		dbg->warning("write_ground_cache()", "failed to write '%s'", cache_name.c_str());
+		dr_remove(tmp_name.c_str());
+		return;
+	}
+	DBG_MESSAGE("write_ground_cache()", "wrote %u ground tiles to '%s'", tiles.get_count(), cache_name.c_str());
+}
+
 /*
  *      called every time an object is read
  *      the object will be assigned according to its name
@@ -615,8 +883,6 @@ void ground_desc_t::init_ground_textures(karte_t *world)
 	image_t *all_rotations_beach[totalslopes]; // water->sand->texture
 	image_t *all_rotations_slope[totalslopes]; // texture1->texture2
 
-	image_t *final_tile = NULL;
-
 	bool full_climate = true;
 	// check if there are double slopes available
 	for(  int imgindex = 16;  imgindex < totalslopes;  imgindex++  ) {
@@ -987,6 +1253,9 @@ void ground_desc_t::init_ground_textures(karte_t *world)
 	// water images for water and overlay
 	water_image = image_offset;
 
+	// first collect all tiles in the order they must be registered
+	vector_tpl<ground_tile_t> tiles(water_animation_stages * totalslopes + (number_of_climates + 2) * totalslopes + 2 * 15 * totalslopes);
+
 	image_t **water_stage_texture = new image_t*[water_animation_stages];
 	for(uint16 stage = 0; stage < water_animation_stages; stage++) {
 		water_stage_texture[stage] = create_texture_from_tile(sea->get_image_ptr(0 /*depth*/, stage), boden_texture->get_image_ptr(water_climate));
@@ -995,35 +1264,27 @@ void ground_desc_t::init_ground_textures(karte_t *world)
 		for(uint16 stage = 0; stage < water_animation_stages; stage++) {
 			if(  doubleslope_to_imgnr[dslope] != 255  ) {
 				int slope = double_grounds ? dslope : slopetable[dslope];
-				final_tile = create_textured_tile( light_map->get_image_ptr( slope ), water_stage_texture[stage], true);
-				ground_image_list.append( final_tile );
+				add_textured_tile( tiles, light_map->get_image_ptr( slope ), water_stage_texture[stage], true );
 			}
 		}
 	}
-	for(uint16 stage = 0; stage < water_animation_stages; stage++) {
-		delete water_stage_texture[stage];
-	}
-	delete [] water_stage_texture;
 
 	// now the other transitions
 	for(  int i=0;  i < number_of_climates;  i++  ) {
 		// normal tile (no transition, not snow)
-		climate_image[i] = get_image_count();
 		for(  int dslope = 0;  dslope < totalslopes - 1;  dslope++  ) {
 			if(  doubleslope_to_imgnr[dslope] != 255  ) {
 				int slope = double_grounds ? dslope : slopetable[dslope];
-				final_tile = create_textured_tile( light_map->get_image_ptr( slope ), boden_texture->get_image_ptr( i+1 ) );
-				ground_image_list.append( final_tile );
+				// the flat tile always exists and comes first
+				add_textured_tile( tiles, light_map->get_image_ptr( slope ), boden_texture->get_image_ptr( i+1 ), false, dslope == 0 ? &climate_image[i] : NULL );
 			}
 		}
 	}
 	// finally full snow
-	climate_image[number_of_climates] = final_tile->get_id() + 1;
 	for(  int dslope = 0;  dslope < totalslopes - 1;  dslope++  ) {
 		if(  doubleslope_to_imgnr[dslope] != 255  ) {
 			int slope = double_grounds ? dslope : slopetable[dslope];
-			final_tile = create_textured_tile( light_map->get_image_ptr( slope ), boden_texture->get_image_ptr( arctic_climate ) );
-			ground_image_list.append( final_tile );
+			add_textured_tile( tiles, light_map->get_image_ptr( slope ), boden_texture->get_image_ptr( arctic_climate ), false, dslope == 0 ? &climate_image[number_of_climates] : NULL );
 		}
 	}
 
@@ -1031,9 +1292,7 @@ void ground_desc_t::init_ground_textures(karte_t *world)
 	for(  int dslope = 1;  dslope < totalslopes - 1;  dslope++  ) {
 		if(  doubleslope_to_imgnr[dslope] != 255  ) {
 			int slope = double_grounds ? dslope : slopetable[dslope];
-			final_tile = create_alpha_tile( light_map->get_image_ptr( slope ), dslope, all_rotations_slope[dslope] );
-			alpha_image[dslope] = final_tile->get_id();
-			ground_image_list.append( final_tile );
+			add_alpha_tile( tiles, light_map->get_image_ptr( slope ), dslope, all_rotations_slope[dslope], &alpha_image[dslope] );
 		}
 		else {
 			alpha_image[dslope] = IMG_EMPTY;
@@ -1050,15 +1309,11 @@ void ground_desc_t::init_ground_textures(karte_t *world)
 				uint8 double_corners = corners == 15 ? 80 : scorner_sw(corners) + 3 * scorner_se(corners) + 9 * scorner_ne(corners) + 27 * scorner_nw(corners);
 
 				// create alpha image
-				final_tile = create_alpha_tile( light_map->get_image_ptr( slope ), dslope, all_rotations_slope[double_corners] );
-				alpha_corners_image[dslope * 15 + corners - 1] = final_tile->get_id();
-				ground_image_list.append( final_tile );
+				add_alpha_tile( tiles, light_map->get_image_ptr( slope ), dslope, all_rotations_slope[double_corners], &alpha_corners_image[dslope * 15 + corners - 1] );
 
 				double_corners = corners == 15 ? 80 : (1 - scorner_sw(corners)) + 3 * (1 - scorner_se(corners)) + 9 * (1 - scorner_ne(corners)) + 27 * (1 - scorner_nw(corners));
 				if(  all_rotations_beach[double_corners]  ) {
-					final_tile = create_alpha_tile( light_map->get_image_ptr( slope ), dslope, all_rotations_beach[double_corners] );
-					alpha_water_image[dslope * 15 + corners - 1] = final_tile->get_id();
-					ground_image_list.append( final_tile );
+					add_alpha_tile( tiles, light_map->get_image_ptr( slope ), dslope, all_rotations_beach[double_corners], &alpha_water_image[dslope * 15 + corners - 1] );
 				}
 			}
 			else {
@@ -1068,6 +1323,34 @@ void ground_desc_t::init_ground_textures(karte_t *world)
 		}
 	}
 
+	// then calculate them (unless they are still in the cache)
+	checksum_t stamp;
+	bool from_cache = false;
+	if(  env_t::ground_texture_cache  ) {
+		calc_ground_cache_stamp( stamp, tiles.get_count() );
+		from_cache = read_ground_cache( stamp, tiles );
+	}
+	if(  !from_cache  ) {
+		calc_ground_tiles( tiles );
+		if(  env_t::ground_texture_cache  ) {
+			write_ground_cache( stamp, tiles );
+		}
+	}
+
+	for(uint16 stage = 0; stage < water_animation_stages; stage++) {
+		delete water_stage_texture[stage];
+	}
+	delete [] water_stage_texture;
+
+	// and finally register them in the original order
+	FOR(vector_tpl<ground_tile_t>, const& tile, tiles) {
+		tile.image->register_image();
+		if(  tile.id  ) {
+			*tile.id = tile.image->get_id();
+		}
+		ground_image_list.append( tile.image );
+	}
+
 #if COLOUR_DEPTH != 0
 	// free the helper bitmap
 	for(  int slope = 1;  slope < totalslopes;  slope++  ) {
@@ -1075,7 +1358,6 @@ void ground_desc_t::init_ground_textures(karte_t *world)
 		delete all_rotations_beach[slope];
 	}
 #endif
-	//dbg->message("ground_desc_t::calc_water_level()", "Last image nr %u", final_tile->get_pic()->imageid);
 	DBG_DEBUG("ground_desc_t::init_ground_textures()", "Init ground textures successful");
 }
 
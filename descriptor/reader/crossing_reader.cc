@@ -92,11 +92,10 @@ obj_desc_t * crossing_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 			for (uint8 i = 0; i<len; i++) {
 				wavname[i] = decode_sint8(p);
 			}
-			desc->sound = (sint16)sound_desc_t::get_sound_id(wavname);
+			sound_to_resolve(&desc->sound, wavname);
 		}
 		else if(desc->sound>=0  &&  desc->sound<=MAX_OLD_SOUNDS) {
-			sint16 old_id = desc->sound;
-			desc->sound = sound_desc_t::get_compatible_sound_id(old_id);
+			old_sound_to_resolve(&desc->sound);
 		}
 
 		desc->intro_date = 0;
@@ -70,6 +70,7 @@ obj_desc_t *factory_field_group_reader_t::read_node(FILE *fp, obj_node_info_t &n
 	ALLOCA(char, desc_buf, node.size);
 
 	field_group_desc_t *desc = new field_group_desc_t();
+	desc->incomplete_field_class_desc = NULL;
 
 	// Read data
 	fread(desc_buf, node.size, 1, fp);
@@ -109,10 +110,10 @@ obj_desc_t *factory_field_group_reader_t::read_node(FILE *fp, obj_node_info_t &n
 		field_class_desc->spawn_weight = 1000;
 
 		/*
-		 * store it in a static variable for further processing
+		 * keep it with the field group for further processing
 		 * later in factory_field_reader_t::register_obj()
 		 */
-		incomplete_field_class_desc = field_class_desc;
+		desc->incomplete_field_class_desc = field_class_desc;
 
 		DBG_DEBUG("factory_field_group_reader_t::read_node()", "version=%i, probability=%i, fields: max=%i / min=%i / start=%i, field classes=%i, storage=%i, field_prod=%i, chance=%i, has_snow=%i",
 			v,
@@ -149,13 +150,13 @@ void factory_field_group_reader_t::register_obj(obj_desc_t *&data)
 	field_group_desc_t *const desc = static_cast<field_group_desc_t *>(data);
 
 	// check if we need to continue with the construction of field class desc
-	if (field_class_desc_t *const field_class_desc = incomplete_field_class_desc) {
+	if (field_class_desc_t *const field_class_desc = desc->incomplete_field_class_desc) {
 		// we *must* transfer the obj_desc_t array and not just the desc object itself
 		// as xref reader has already logged the address of the array element for xref resolution
-		field_class_desc->children  = desc->children;
-		desc->children              = new obj_desc_t*[1];
-		desc->children[0]           = field_class_desc;
-		incomplete_field_class_desc = NULL;
+		field_class_desc->children        = desc->children;
+		desc->children                    = new obj_desc_t*[1];
+		desc->children[0]                 = field_class_desc;
+		desc->incomplete_field_class_desc = NULL;
 	}
 }
 
@@ -595,14 +596,10 @@ obj_desc_t *factory_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 		for (uint8 i = 0; i<len; i++) {
 			wavname[i] = decode_sint8(p);
 		}
-		desc->sound_id = (sint8)sound_desc_t::get_sound_id(wavname);
-		DBG_MESSAGE("vehicle_reader_t::register_obj()", "sound %s to %i", wavname, desc->sound_id);
-
+		sound_to_resolve((sint16 *)&desc->sound_id, wavname, true);
 	}
 	else if (desc->sound_id >= 0 && desc->sound_id <= MAX_OLD_SOUNDS) {
-		sint16 old_id = desc->sound_id;
-		desc->sound_id = (sint8)sound_desc_t::get_compatible_sound_id((sint8)old_id);
-		DBG_MESSAGE("vehicle_reader_t::register_obj()", "old sound %i to %i", old_id, desc->sound_id);
+		old_sound_to_resolve((sint16 *)&desc->sound_id, true);
 	}
 
 	return desc;
@@ -36,9 +36,6 @@ class factory_field_group_reader_t : public obj_reader_t {
 
 	factory_field_group_reader_t() { register_reader(); }
 
-	// hold a field class desc under construction
-	static field_class_desc_t* incomplete_field_class_desc;
-
 protected:
 	/// @copydoc obj_reader_t::register_obj
 	void register_obj(obj_desc_t *&desc) OVERRIDE;
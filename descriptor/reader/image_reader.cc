@@ -162,6 +162,16 @@ adjust_image:
 		}
 	}
 
+	return desc;
+}
+
+
+void image_reader_t::register_obj(obj_desc_t *&data)
+{
+	// Images are registered only here and not already in read_node(),
+	// since image ids must be assigned in pak file order, even if the files are read in parallel.
+	image_t *desc = static_cast<image_t *>(data);
+
 	if (desc->len != 0) {
 		// get the adler hash (since we have zlib on board anyway ... )
 		bool do_register_image = true;
@@ -197,6 +207,5 @@ adjust_image:
 			desc = same;
 		}
 	}
-
-	return desc;
+	data = desc;
 }
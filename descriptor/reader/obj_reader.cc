@@ -15,6 +15,7 @@
 
 #include "../skin_desc.h"   // just for the logo
 #include "../ground_desc.h" // for the error message!
+#include "../sound_desc.h"
 #include "../../simskin.h"
 
 // normal stuff
@@ -34,11 +35,32 @@
 
 #include "obj_reader.h"
 
+#ifdef MULTI_THREAD
+#include "../../utils/simthread.h"
+#endif
+
+// stdio buffer for reading a single pak file
+#define PAK_READ_BUFFER_SIZE (256 * 1024)
+
+#ifdef MULTI_THREAD
+// parameters of the pak reading threads
+struct obj_reader_t::parse_files_t
+{
+	parsed_file_t *files;
+	sint32 count;
+	sint32 next;   // next file to be read by any thread
+	bool *parsed;  // true, if files[i] is ready for registration
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+};
+#endif
+
 
 obj_reader_t::obj_map*                                        obj_reader_t::obj_reader;
 inthashtable_tpl<obj_type, stringhashtable_tpl<obj_desc_t*, N_BAGS_LARGE>, N_BAGS_LARGE> obj_reader_t::loaded;
 obj_reader_t::unresolved_map                                  obj_reader_t::unresolved;
 ptrhashtable_tpl<obj_desc_t**, int, N_BAGS_SMALL>             obj_reader_t::fatals;
+thread_local vector_tpl<obj_reader_t::pending_registration_t> *obj_reader_t::pending_in_thread = NULL;
 
 void obj_reader_t::register_reader()
 {
@@ -147,15 +169,71 @@ DBG_MESSAGE("obj_reader_t::load()","big logo %p", skinverwaltung_t::biglogosymbo
 
 DBG_MESSAGE("obj_reader_t::load()", "reading from '%s'", name.c_str());
 
+		parsed_file_t *files = new parsed_file_t[max];
 		uint n = 0;
 		FORX(searchfolder_t, const& i, find, ++n) {
-			read_file(i);
+			files[n].name = i;
+			files[n].root = NULL;
+		}
+
+#ifdef MULTI_THREAD
+		// The files are read by worker threads in parallel, while the main thread
+		// registers them one after another in the same order as without threads.
+		const int num_threads = env_t::num_threads > 1 ? min(env_t::num_threads, max) : 0;
+		parse_files_t parse_files;
+		parse_files.files = files;
+		parse_files.count = max;
+		parse_files.next = 0;
+		parse_files.parsed = new bool[max];
+		for(  sint32 j = 0;  j < max;  j++  ) {
+			parse_files.parsed[j] = false;
+		}
+		pthread_mutex_init(&parse_files.mutex, NULL);
+		pthread_cond_init(&parse_files.cond, NULL);
+
+		pthread_t *threads = new pthread_t[num_threads];
+		pthread_attr_t attr;
+		pthread_attr_init(&attr);
+		pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+		int started = 0;
+		while(  started < num_threads  &&  pthread_create(&threads[started], &attr, parse_files_thread, (void *)&parse_files) == 0  ) {
+			started++;
+		}
+		pthread_attr_destroy(&attr);
+#endif
+
+		for(  n = 0;  n < (uint)max;  n++  ) {
+#ifdef MULTI_THREAD
+			if(  started > 0  ) {
+				pthread_mutex_lock(&parse_files.mutex);
+				while(  !parse_files.parsed[n]  ) {
+					pthread_cond_wait(&parse_files.cond, &parse_files.mutex);
+				}
+				pthread_mutex_unlock(&parse_files.mutex);
+			}
+			else
+#endif
+			{
+				parse_file(files[n]);
+			}
+			register_file(files[n]);
 			if ((n & step) == 0 && drawing) {
 				ls.set_progress(n);
 			}
 		}
 		ls.set_progress(max);
 
+#ifdef MULTI_THREAD
+		for(  int t = 0;  t < started;  t++  ) {
+			pthread_join(threads[t], NULL);
+		}
+		delete [] threads;
+		delete [] parse_files.parsed;
+		pthread_cond_destroy(&parse_files.cond);
+		pthread_mutex_destroy(&parse_files.mutex);
+#endif
+		delete [] files;
+
 		return find.begin()!=find.end();
 	}
 	return false;
@@ -164,10 +242,25 @@ DBG_MESSAGE("obj_reader_t::load()", "reading from '%s'", name.c_str());
 
 void obj_reader_t::read_file(const char *name)
 {
+	parsed_file_t file;
+	file.name = name;
+	file.root = NULL;
+	parse_file(file);
+	register_file(file);
+}
+
+
+void obj_reader_t::parse_file(parsed_file_t &file)
+{
+	const char *name = file.name;
+
 	// added trace
 	DBG_DEBUG("obj_reader_t::read_file()", "filename='%s'", name);
 
 	if (FILE* const fp = dr_fopen(name, "rb")) {
+		// nodes are read with many small freads, so give the stream a generous buffer
+		setvbuf(fp, NULL, _IOFBF, PAK_READ_BUFFER_SIZE);
+
 		sint32 n = 0;
 
 		// This is the normal header reading code
@@ -195,8 +288,9 @@ void obj_reader_t::read_file(const char *name)
 		DBG_DEBUG("obj_reader_t::read_file()", "read %d blocks, file version is %x", n, version);
 
 		if(version <= COMPILER_VERSION_CODE) {
-			obj_desc_t *data = NULL;
-			read_nodes(fp, data, 0, version );
+			pending_in_thread = &file.pending;
+			read_nodes(fp, file.root, 0, version );
+			pending_in_thread = NULL;
 		}
 		else {
 			DBG_DEBUG("obj_reader_t::read_file()","version of '%s' is too old, %d instead of %d", name, version, COMPILER_VERSION_CODE );
@@ -209,6 +303,54 @@ void obj_reader_t::read_file(const char *name)
 }
 
 
+void obj_reader_t::register_file(parsed_file_t &file)
+{
+	FOR(vector_tpl<pending_registration_t>, const& i, file.pending) {
+		if(  i.reader  ) {
+			i.reader->register_obj(*i.desc);
+		}
+		else {
+			sint16 id;
+			if(  i.sound_name  ) {
+				id = sound_desc_t::get_sound_id(i.sound_name);
+				DBG_MESSAGE("obj_reader_t::register_file()", "sound %s to %i", i.sound_name, id);
+				free(i.sound_name);
+			}
+			else {
+				id = sound_desc_t::get_compatible_sound_id((sint8)*i.sound);
+				DBG_MESSAGE("obj_reader_t::register_file()", "old sound %i to %i", *i.sound, id);
+			}
+			*i.sound = i.sint8_id ? (sint8)id : id;
+		}
+	}
+	file.pending.clear();
+}
+
+
+#ifdef MULTI_THREAD
+void *obj_reader_t::parse_files_thread(void *args)
+{
+	parse_files_t *const param = reinterpret_cast<parse_files_t *>(args);
+	while(  true  ) {
+		pthread_mutex_lock(&param->mutex);
+		const sint32 n = param->next++;
+		pthread_mutex_unlock(&param->mutex);
+		if(  n >= param->count  ) {
+			break;
+		}
+
+		parse_file(param->files[n]);
+
+		pthread_mutex_lock(&param->mutex);
+		param->parsed[n] = true;
+		pthread_cond_broadcast(&param->cond);
+		pthread_mutex_unlock(&param->mutex);
+	}
+	return NULL;
+}
+#endif
+
+
 static void read_node_info(obj_node_info_t& node, FILE* const f, uint32 const version)
 {
 	char data[EXT_OBJ_NODE_INFO_SIZE];
@@ -246,7 +388,14 @@ void obj_reader_t::read_nodes(FILE* fp, obj_desc_t*& data, int register_nodes, u
 //DBG_DEBUG("obj_reader_t","registering with '%s'", reader->get_type_name());
 		if(register_nodes<2  ||  node.type!=obj_cursor) {
 			// since many buildings are with cursors that do not need registration
-			reader->register_obj(data);
+			// registration itself is done later by register_file()
+			pending_registration_t registration;
+			registration.reader = reader;
+			registration.desc = &data;
+			registration.sound = NULL;
+			registration.sound_name = NULL;
+			registration.sint8_id = false;
+			pending_in_thread->append(registration);
 		}
 	}
 	else {
@@ -273,6 +422,30 @@ void obj_reader_t::skip_nodes(FILE *fp,uint32 version)
 }
 
 
+void obj_reader_t::sound_to_resolve(sint16 *dest, const char *wavname, bool sint8_id)
+{
+	pending_registration_t sound;
+	sound.reader = NULL;
+	sound.desc = NULL;
+	sound.sound = dest;
+	sound.sound_name = strdup(wavname);
+	sound.sint8_id = sint8_id;
+	pending_in_thread->append(sound);
+}
+
+
+void obj_reader_t::old_sound_to_resolve(sint16 *dest, bool sint8_id)
+{
+	pending_registration_t sound;
+	sound.reader = NULL;
+	sound.desc = NULL;
+	sound.sound = dest;
+	sound.sound_name = NULL;
+	sound.sint8_id = sint8_id;
+	pending_in_thread->append(sound);
+}
+
+
 void obj_reader_t::resolve_xrefs()
 {
 	slist_tpl<obj_desc_t *> xref_nodes;
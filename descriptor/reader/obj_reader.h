@@ -14,6 +14,7 @@
 #include "../../simdebug.h"
 #include "../../simtypes.h"
 #include "../../macros.h"
+#include "../../tpl/vector_tpl.h"
 
 
 class obj_desc_t;
@@ -80,9 +81,44 @@ class obj_reader_t
 	static unresolved_map unresolved;
 	static ptrhashtable_tpl<obj_desc_t **, int, N_BAGS_SMALL>  fatals;
 
+	/// A node read by read_nodes() or a sound requested by read_node(), whose registration is still pending.
+	struct pending_registration_t
+	{
+		obj_reader_t *reader; // NULL for sounds
+		obj_desc_t **desc;
+		sint16 *sound;        // receives the sound id
+		char *sound_name;     // NULL for an old sound number in *sound
+		bool sint8_id;        // sound id is truncated to sint8 (factories)
+	};
+
+	/// Registrations requested while reading a file in the current thread.
+	static thread_local vector_tpl<pending_registration_t> *pending_in_thread;
+
+	/**
+	 * A pak file, whose nodes have been read but not yet registered.
+	 * Reading can happen in any order (and in parallel), registration is done in file order.
+	 */
+	struct parsed_file_t
+	{
+		const char *name;
+		obj_desc_t *root;
+		vector_tpl<pending_registration_t> pending;
+	};
+
 	static void read_nodes(FILE* fp, obj_desc_t*& data, int register_nodes,uint32 version);
 	static void skip_nodes(FILE *fp,uint32 version);
 
+	/// Reads all nodes of a pak file. Does not touch any global state, thus can be called from several threads at once.
+	static void parse_file(parsed_file_t &file);
+
+	/// Registers the nodes of a parsed file in the order the single threaded reader would have done.
+	static void register_file(parsed_file_t &file);
+
+#ifdef MULTI_THREAD
+	struct parse_files_t;
+	static void *parse_files_thread(void *args);
+#endif
+
 protected:
 	obj_reader_t() { /* Beware: Cannot register here! */}
 	virtual ~obj_reader_t() {}
@@ -91,6 +127,14 @@ protected:
 	static void xref_to_resolve(obj_type type, const char *name, obj_desc_t **dest, bool fatal);
 	static void resolve_xrefs();
 
+	/**
+	 * Sounds must not be loaded in read_node(), since sound ids are assigned in load order.
+	 * Instead read_node() requests the sound from the file @p wavname (or the old sound number
+	 * in *dest) and *dest gets the sound id, when the nodes of the file are registered.
+	 */
+	static void sound_to_resolve(sint16 *dest, const char *wavname, bool sint8_id = false);
+	static void old_sound_to_resolve(sint16 *dest, bool sint8_id = false);
+
 	/// Read a descriptor from @p fp. Does version check and compatibility transformations.
 	/// @returns The descriptor on success, or NULL on failure
 	virtual obj_desc_t *read_node(FILE *fp, obj_node_info_t &node) = 0;
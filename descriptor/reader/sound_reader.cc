@@ -16,6 +16,10 @@
 void sound_reader_t::register_obj(obj_desc_t *&data)
 {
 	sound_desc_t *desc = static_cast<sound_desc_t *>(data);
+	if(  !desc->nr_file.empty()  ) {
+		// sounds are loaded only here, since sample ids must be assigned in pak file order
+		desc->nr = sound_desc_t::get_sound_id(desc->nr_file.c_str());
+	}
 	sound_desc_t::register_desc(desc);
 	DBG_DEBUG("sound_reader_t::read_node()","sound %s registered at %i",desc->get_name(),desc->sound_id);
 	delete desc;
@@ -44,7 +48,7 @@ obj_desc_t * sound_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 		desc->nr = decode_uint16(p);
 		uint16 len = decode_uint16(p);
 		if(  len>0  ) {
-			desc->nr = desc->get_sound_id(p);
+			desc->nr_file = p;
 		}
 	}
 	else {
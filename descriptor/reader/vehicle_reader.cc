@@ -726,13 +726,10 @@ obj_desc_t *vehicle_reader_t::read_node(FILE *fp, obj_node_info_t &node)
 		for(uint8 i=0; i<len; i++) {
 			wavname[i] = decode_sint8(p);
 		}
-		desc->sound = (sint16)sound_desc_t::get_sound_id(wavname);
-DBG_MESSAGE("vehicle_reader_t::register_obj()","sound %s to %i",wavname,desc->sound);
+		sound_to_resolve(&desc->sound, wavname);
 	}
 	else if(desc->sound>=0  &&  desc->sound<=MAX_OLD_SOUNDS) {
-		sint16 old_id = desc->sound;
-		desc->sound = (sint16)sound_desc_t::get_compatible_sound_id(old_id);
-DBG_MESSAGE("vehicle_reader_t::register_obj()","old sound %i to %i",old_id,desc->sound);
+		old_sound_to_resolve(&desc->sound);
 	}
 	desc->loaded();
 
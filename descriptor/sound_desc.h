@@ -7,6 +7,8 @@
 #define DESCRIPTOR_SOUND_DESC_H
 
 
+#include <string>
+
 #include "obj_base_desc.h"
 #include "../simtypes.h"
 
@@ -43,6 +45,7 @@ private:
 
 	sint16 sound_id;
 	sint16 nr; // for old sounds/system sounds etc.
+	std::string nr_file; // file of the system sound in nr, resolved on registration
 
 public:
 	// sounds for ambient
@@ -425,6 +425,9 @@ void display_pop_clip_wh(CLIP_NUM_DEF0);
 
 bool display_snapshot( const scr_rect &area );
 
+/// saves the area of the screen to the given file; the format (.ppm, .bmp, otherwise png) is chosen by the extension
+bool display_snapshot_to_file( const scr_rect &area, const char *filename );
+
 #if COLOUR_DEPTH != 0
 extern uint8 display_day_lights[  LIGHT_COUNT * 3];
 extern uint8 display_night_lights[LIGHT_COUNT * 3];
@@ -136,6 +136,11 @@ bool display_snapshot(const scr_rect &)
 	return false;
 }
 
+bool display_snapshot_to_file(const scr_rect &, const char *)
+{
+	return false;
+}
+
 void display_get_image_offset(image_id image, scr_coord_val *xoff, scr_coord_val *yoff, scr_coord_val *xw, scr_coord_val *yw)
 {
 	if(  image < 2  ) {
@@ -61,6 +61,25 @@ static pthread_mutex_t recode_img_mutex;
 
 #include "simgraph.h"
 
+/*
+ * SIMD versions of the hottest pixel loops
+ * SSE2 is part of every x86-64 CPU, AVX2 is only used if the CPU reports it at runtime.
+ * The scalar routines stay as fallback and all versions give identical pixels.
+ */
+#if defined(__SSE2__)  ||  defined(_M_X64)
+#	define SIMGRAPH_SSE2
+#	include <emmintrin.h>
+#	if defined(__GNUC__)  &&  (__GNUC__ >= 5  ||  defined(__clang__))
+#		define SIMGRAPH_AVX2
+#		define AVX2_TARGET __attribute__((target("avx2")))
+#		include <immintrin.h>
+#	endif
+#endif
+
+#ifdef SIMGRAPH_AVX2
+static bool use_avx2 = false;
+#endif
+
 // undefine for debugging the update routines
 //#define DEBUG_FLUSH_BUFFER
 
@@ -268,13 +287,13 @@ int default_font_linespace = 0;
  * The following transparent colors are not in the colortable
  * 0x8020 - 0xFFE1: 3 4 3 RGB transparent colors in 31 transparency levels
  */
-static PIXVAL rgbmap_day_night[RGBMAPSIZE];
+static PIXVAL rgbmap_day_night[RGBMAPSIZE+1]; // one spare entry, since the AVX2 lookup reads 32 bit
 
 
 /*
  * same as rgbmap_day_night, but always daytime colors
  */
-static PIXVAL rgbmap_all_day[RGBMAPSIZE];
+static PIXVAL rgbmap_all_day[RGBMAPSIZE+1];
 
 
 /*
@@ -1273,6 +1292,26 @@ static void recode()
 }
 
 
+#ifdef SIMGRAPH_AVX2
+/**
+ * Translates the pixels from src to end through a colour table, eight pixels at a time.
+ * The gather reads 32 bit per pixel, hence the tables need one spare entry at the end.
+ */
+AVX2_TARGET static void pixrecode_avx2(PIXVAL *dest, const PIXVAL *src, const PIXVAL *const end, const PIXVAL *table)
+{
+	const __m256i low_word = _mm256_set1_epi32(0xFFFF);
+	for(  ;  src + 8 <= end;  src += 8, dest += 8  ) {
+		const __m256i index = _mm256_cvtepu16_epi32( _mm_loadu_si128( (const __m128i *)src ) );
+		const __m256i pix = _mm256_and_si256( _mm256_i32gather_epi32( (const int *)table, index, 2 ), low_word );
+		_mm_storeu_si128( (__m128i *)dest, _mm_packus_epi32( _mm256_castsi256_si128(pix), _mm256_extracti128_si256(pix, 1) ) );
+	}
+	while(  src < end  ) {
+		*dest++ = table[*src++];
+	}
+}
+#endif
+
+
 // to switch between 15 bit and 16 bit recoding ...
 typedef void (*display_recode_img_src_target_proc)(scr_coord_val h, PIXVAL *src, PIXVAL *target);
 static display_recode_img_src_target_proc recode_img_src_target = NULL;
@@ -1308,6 +1347,14 @@ static void recode_img_src_target_15(scr_coord_val h, PIXVAL *src, PIXVAL *targe
 				}
 				else {
 					// now just convert the color pixels
+#ifdef SIMGRAPH_AVX2
+					if(  use_avx2  ) {
+						pixrecode_avx2( target, src, src + runlen, rgbmap_day_night );
+						target += runlen;
+						src += runlen;
+						runlen = 0;
+					}
+#endif
 					while(  runlen--  ) {
 						*target++ = rgbmap_day_night[*src++];
 					}
@@ -1345,6 +1392,14 @@ static void recode_img_src_target_16(scr_coord_val h, PIXVAL *src, PIXVAL *targe
 				}
 				else {
 					// now just convert the color pixels
+#ifdef SIMGRAPH_AVX2
+					if(  use_avx2  ) {
+						pixrecode_avx2( target, src, src + runlen, rgbmap_day_night );
+						target += runlen;
+						src += runlen;
+						runlen = 0;
+					}
+#endif
 					while(  runlen--  ) {
 						*target++ = rgbmap_day_night[*src++];
 					}
@@ -2282,6 +2337,12 @@ static inline void pixcopy(PIXVAL *dest, const PIXVAL *src, const PIXVAL * const
 static inline void colorpixcopy(PIXVAL* dest, const PIXVAL* src, const PIXVAL* const end)
 {
 	if (*src < 0x8020) {
+#ifdef SIMGRAPH_AVX2
+		if(  use_avx2  ) {
+			pixrecode_avx2(dest, src, end, rgbmap_current);
+			return;
+		}
+#endif
 		while (src < end) {
 			*dest++ = rgbmap_current[*src++];
 		}
@@ -2320,6 +2381,12 @@ static inline void colorpixcopy(PIXVAL* dest, const PIXVAL* src, const PIXVAL* c
 static inline void colorpixcopy(PIXVAL* dest, const PIXVAL* src, const PIXVAL* const end)
 {
 	if (*src < 0x8020) {
+#ifdef SIMGRAPH_AVX2
+		if(  use_avx2  ) {
+			pixrecode_avx2(dest, src, end, rgbmap_current);
+			return;
+		}
+#endif
 		while (src < end) {
 			*dest++ = rgbmap_current[*src++];
 		}
@@ -2368,6 +2435,12 @@ static inline void colorpixcopy(PIXVAL* dest, const PIXVAL* src, const PIXVAL* c
 static inline void colorpixcopydaytime(PIXVAL* dest, const PIXVAL* src, const PIXVAL* const end)
 {
 	if (*src < 0x8020) {
+#ifdef SIMGRAPH_AVX2
+		if(  use_avx2  ) {
+			pixrecode_avx2(dest, src, end, rgbmap_current);
+			return;
+		}
+#endif
 		while (src < end) {
 			*dest++ = rgbmap_current[*src++];
 		}
@@ -2406,6 +2479,12 @@ static inline void colorpixcopydaytime(PIXVAL* dest, const PIXVAL* src, const PI
 static inline void colorpixcopydaytime(PIXVAL* dest, const PIXVAL* src, const PIXVAL* const end)
 {
 	if (*src < 0x8020) {
+#ifdef SIMGRAPH_AVX2
+		if(  use_avx2  ) {
+			pixrecode_avx2(dest, src, end, rgbmap_current);
+			return;
+		}
+#endif
 		while (src < end) {
 			*dest++ = rgbmap_current[*src++];
 		}
@@ -3435,12 +3514,111 @@ static void pix_outline25_16(PIXVAL *dest, const PIXVAL *, const PIXVAL colour,
 }
 
 
+#ifdef SIMGRAPH_SSE2
+/**
+ * SIMD version of the pix_blend and pix_outline functions above:
+ * dest = src_factor*((src>>shift) & mask) + dest_factor*((dest>>shift) & mask)
+ * For outlines, src is the constant colour. All in 16 bit, like the scalar versions.
+ */
+template<int shift, PIXVAL mask, int src_factor, int dest_factor, bool use_colour>
+static void pix_blend_sse2(PIXVAL *dest, const PIXVAL *src, const PIXVAL colour, const PIXVAL len)
+{
+	const PIXVAL *const end = dest + len;
+	const __m128i m = _mm_set1_epi16( (short)mask );
+	const __m128i fs = _mm_set1_epi16( src_factor );
+	const __m128i fd = _mm_set1_epi16( dest_factor );
+	const __m128i col = _mm_set1_epi16( (short)colour );
+	for(  ;  dest + 8 <= end;  dest += 8  ) {
+		__m128i s = col;
+		if(  !use_colour  ) {
+			s = _mm_loadu_si128( (const __m128i *)src );
+			src += 8;
+		}
+		const __m128i d = _mm_loadu_si128( (const __m128i *)dest );
+		s = _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( s, shift ), m ), fs );
+		_mm_storeu_si128( (__m128i *)dest, _mm_add_epi16( s, _mm_mullo_epi16( _mm_and_si128( _mm_srli_epi16( d, shift ), m ), fd ) ) );
+	}
+	for(  ;  dest < end;  dest++  ) {
+		const PIXVAL s = use_colour ? colour : *src++;
+		*dest = src_factor*((s>>shift) & mask) + dest_factor*(((*dest)>>shift) & mask);
+	}
+}
+#endif
+
+
+#ifdef SIMGRAPH_AVX2
+template<int shift, PIXVAL mask, int src_factor, int dest_factor, bool use_colour>
+AVX2_TARGET static void pix_blend_avx2(PIXVAL *dest, const PIXVAL *src, const PIXVAL colour, const PIXVAL len)
+{
+	const PIXVAL *const end = dest + len;
+	const __m256i m = _mm256_set1_epi16( (short)mask );
+	const __m256i fs = _mm256_set1_epi16( src_factor );
+	const __m256i fd = _mm256_set1_epi16( dest_factor );
+	const __m256i col = _mm256_set1_epi16( (short)colour );
+	for(  ;  dest + 16 <= end;  dest += 16  ) {
+		__m256i s = col;
+		if(  !use_colour  ) {
+			s = _mm256_loadu_si256( (const __m256i *)src );
+			src += 16;
+		}
+		const __m256i d = _mm256_loadu_si256( (const __m256i *)dest );
+		s = _mm256_mullo_epi16( _mm256_and_si256( _mm256_srli_epi16( s, shift ), m ), fs );
+		_mm256_storeu_si256( (__m256i *)dest, _mm256_add_epi16( s, _mm256_mullo_epi16( _mm256_and_si256( _mm256_srli_epi16( d, shift ), m ), fd ) ) );
+	}
+	for(  ;  dest < end;  dest++  ) {
+		const PIXVAL s = use_colour ? colour : *src++;
+		*dest = src_factor*((s>>shift) & mask) + dest_factor*(((*dest)>>shift) & mask);
+	}
+}
+#endif
+
+
 // will kept the actual values
 static blend_proc blend[3];
 static blend_proc blend_recode[3];
 static blend_proc outline[3];
 
 
+#define SET_SIMD_BLEND_PROCS(kernel, bits) \
+	blend[0] = kernel<2, TWO_OUT_##bits, 1, 3, false>; \
+	blend[1] = kernel<1, ONE_OUT_##bits, 1, 1, false>; \
+	blend[2] = kernel<2, TWO_OUT_##bits, 3, 1, false>; \
+	outline[0] = kernel<2, TWO_OUT_##bits, 1, 3, true>; \
+	outline[1] = kernel<1, ONE_OUT_##bits, 1, 1, true>; \
+	outline[2] = kernel<2, TWO_OUT_##bits, 3, 1, true>;
+
+/**
+ * replaces the scalar blend and outline functions by the fastest SIMD versions for this CPU
+ */
+static void select_simd_blend_procs()
+{
+#ifdef SIMGRAPH_AVX2
+	__builtin_cpu_init();
+	use_avx2 = __builtin_cpu_supports("avx2");
+	if(  use_avx2  ) {
+		if(  bitdepth == 15  ) {
+			SET_SIMD_BLEND_PROCS(pix_blend_avx2, 15)
+		}
+		else {
+			SET_SIMD_BLEND_PROCS(pix_blend_avx2, 16)
+		}
+		DBG_MESSAGE("select_simd_blend_procs()", "using AVX2");
+		return;
+	}
+#endif
+#ifdef SIMGRAPH_SSE2
+	if(  bitdepth == 15  ) {
+		SET_SIMD_BLEND_PROCS(pix_blend_sse2, 15)
+	}
+	else {
+		SET_SIMD_BLEND_PROCS(pix_blend_sse2, 16)
+	}
+	DBG_MESSAGE("select_simd_blend_procs()", "using SSE2");
+#endif
+}
+#undef SET_SIMD_BLEND_PROCS
+
+
 /**
  * Blends a rectangular region with a color
  */
@@ -3473,7 +3651,7 @@ void display_blend_wh_rgb(scr_coord_val xp, scr_coord_val yp, scr_coord_val w, s
 
 			default:
 				// any percentage blending: SLOW!
-				if(  blend[0] == pix_blend25_15  ) {
+				if(  bitdepth == 15  ) {
 					// 555 BITMAPS
 					const PIXVAL r_src = (colval >> 10) & 0x1F;
 					const PIXVAL g_src = (colval >> 5) & 0x1F;
@@ -5940,6 +6118,7 @@ bool simgraph_init(scr_size window_size, bool full_screen)
 			dr_fatal_notify( "Compiled for 15 bit color depth but using 16!" );
 #endif
 		}
+		select_simd_blend_procs();
 	}
 
 	return true;
@@ -6032,14 +6211,20 @@ bool display_snapshot( const scr_rect &area )
 	} while (access(filename, W_OK) != -1);
 
 	// now save the screenshot
+	return display_snapshot_to_file(area, filename);
+}
+
+
+bool display_snapshot_to_file( const scr_rect &area, const char *filename )
+{
 	scr_rect clipped_area = area;
 	clipped_area.clip(scr_rect(0, 0, disp_actual_width, disp_height));
 
 	raw_image_t img(clipped_area.w, clipped_area.h, raw_image_t::FMT_RGB888);
 
 	for (scr_coord_val y = clipped_area.y; y < clipped_area.y + clipped_area.h; ++y) {
-		uint8 *dst = img.access_pixel(0, y);
-		const PIXVAL *row = textur + 0 + y*disp_width;
+		uint8 *dst = img.access_pixel(0, y - clipped_area.y);
+		const PIXVAL *row = textur + clipped_area.x + y*disp_width;
 
 		for (scr_coord_val x = clipped_area.x; x < clipped_area.x + clipped_area.w; ++x) {
 			const PIXVAL pixel = *row++;
@@ -6056,5 +6241,12 @@ bool display_snapshot( const scr_rect &area )
 		}
 	}
 
+	const char *ext = strrchr(filename, '.');
+	if(  ext  &&  STRICMP(ext, ".ppm") == 0  ) {
+		return img.write_ppm(filename);
+	}
+	if(  ext  &&  STRICMP(ext, ".bmp") == 0  ) {
+		return img.write_bmp(filename);
+	}
 	return img.write_png(filename);
 }
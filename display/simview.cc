@@ -23,9 +23,18 @@
 #include "../obj/zeiger.h"
 
 #include "../utils/simrandom.h"
+#include "../sys/simsys.h"
 
 uint16 win_get_statusbar_height(); // simwin.h
 
+// time spent by each thread in display_region() during the last display() call
+static uint32 region_time_us[MAX_THREADS];
+
+uint32 main_view_t::get_region_time_us(uint8 thread_num)
+{
+	return thread_num < MAX_THREADS ? region_time_us[thread_num] : 0;
+}
+
 main_view_t::main_view_t(karte_t *welt)
 {
 	this->welt = welt;
@@ -74,7 +83,9 @@ void *display_region_thread( void *ptr )
 		simthread_barrier_wait( &display_barrier_start ); // wait for all to start
 		clear_all_poly_clip( view->thread_num );
 		display_set_clip_wh( view->lt_cl.x, view->lt_cl.y, view->wh_cl.x, view->wh_cl.y, view->thread_num );
+		const uint64 start = dr_time_us();
 		view->show_routine->display_region( view->lt, view->wh, view->y_min, view->y_max, false, true, view->thread_num );
+		region_time_us[view->thread_num] = (uint32)(dr_time_us() - start);
 		simthread_barrier_wait( &display_barrier_end ); // wait for all to finish
 	}
 }
@@ -252,7 +263,9 @@ void main_view_t::display(bool force_dirty)
 		// the last we can run ourselves, setting clip_wh to the screen edge instead of wh_x (in case disp_width % num_threads != 0)
 		clear_all_poly_clip( env_t::num_threads - 1 );
 		display_set_clip_wh( lt_x, clip_rr.y, clip_rr.w, clip_rr.h, env_t::num_threads - 1 );
+		const uint64 start = dr_time_us();
 		display_region( koord( lt_x - IMG_SIZE / 2, clip_rr.y ), koord( clip_rr.x + clip_rr.w + IMG_SIZE, clip_rr.h ), y_min, dpy_height + 4 * 4, false, true, env_t::num_threads - 1 );
+		region_time_us[env_t::num_threads - 1] = (uint32)(dr_time_us() - start);
 
 		simthread_barrier_wait( &display_barrier_end );
 
@@ -262,11 +275,15 @@ void main_view_t::display(bool force_dirty)
 	else {
 		// slow serial way of display
 		clear_all_poly_clip( 0 );
+		const uint64 start = dr_time_us();
 		display_region( koord(clip_rr.x, clip_rr.y), koord(clip_rr.w, clip_rr.h), y_min, dpy_height + 4 * 4, false, false, 0 );
+		region_time_us[0] = (uint32)(dr_time_us() - start);
 	}
 #else
 	clear_all_poly_clip();
+	const uint64 start = dr_time_us();
 	display_region(koord(clip_rr.x, clip_rr.y), koord(clip_rr.w, clip_rr.h), y_min, dpy_height + 4 * 4, false );
+	region_time_us[0] = (uint32)(dr_time_us() - start);
 #endif
 
 	// and finally overlays (station coverage and signs)
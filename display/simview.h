@@ -48,6 +48,9 @@ public:
 	 */
 	void clear_prepared() const;
 
+	/// Time in microseconds the given display thread spent in display_region() during the last display() call.
+	static uint32 get_region_time_us(uint8 thread_num);
+
 	/**
 	 * Draws the simulated world in the specified rectangular area of the pixel buffer. This is a internal function of the class.
 	 * <br>
@@ -19,6 +19,7 @@
 #include "../dataobj/translator.h"
 #include "../dataobj/schedule.h"
 #include "../dataobj/powernet.h"
+#include "../dataobj/environment.h"
 
 #include "../boden/wege/schiene.h"
 #include "../obj/leitung2.h"
@@ -28,6 +29,7 @@
 #include "../player/simplay.h"
 
 #include "../tpl/inthashtable_tpl.h"
+#include "../utils/simthread.h"
 
 #include <cmath>
 
@@ -615,6 +617,19 @@ PIXVAL minimap_t::calc_severity_color_log(sint32 amount, sint32 max_value)
 }
 
 
+uint32 minimap_t::get_tile_index(koord k) const
+{
+	return (uint32)k.y * (uint32)layer_size.x + (uint32)k.x;
+}
+
+
+bool minimap_t::is_in_layers(koord k) const
+{
+	// the map may already be enlarged or rotated before init() is called
+	return ground_layer!=nullptr  &&  0<=k.x  &&  k.x<layer_size.x  &&  0<=k.y  &&  k.y<layer_size.y;
+}
+
+
 void minimap_t::set_map_color_clip( sint16 x, sint16 y, PIXVAL color )
 {
 	if(  0<=x  &&  (uint16)x < map_data->get_width()  &&  0<=y  &&  (uint16)y < map_data->get_height()  ) {
@@ -790,28 +805,99 @@ PIXVAL minimap_t::calc_ground_color(const grund_t *gr, bool show_contour, bool s
 
 void minimap_t::calc_map_pixel(const koord k)
 {
-	// no pixels visible, so noting to calculate
-	if(!is_visible) {
+	if(  !is_in_layers(k)  ) {
+		// nothing cached yet, the next calc_map() computes everything
+		return;
+	}
+	const uint32 idx = get_tile_index(k);
+	ground_layer->flags[idx] &= ~LAYER_VALID;
+	FOR(vector_tpl<tile_layer_t*>, const layer, overlay_layers) {
+		layer->flags[idx] &= ~LAYER_VALID;
+	}
+	add_pending_tile(k);
+}
+
+
+void minimap_t::calc_convoy_pixel(const koord k)
+{
+	if(  is_in_layers(k)  ) {
+		add_pending_tile(k);
+	}
+}
+
+
+void minimap_t::add_pending_tile(const koord k)
+{
+	// no pixels visible, so nothing to update
+	if(  !is_visible  ) {
+		return;
+	}
+	uint8 &flags = ground_layer->flags[get_tile_index(k)];
+	if(  (flags & LAYER_PENDING) == 0  ) {
+		flags |= LAYER_PENDING;
+		pending_tiles.append(k);
+	}
+}
+
+
+const grund_t *minimap_t::get_map_ground(const planquadrat_t *plan) const
+{
+	// When displaying buildings, give priority to buildings over tunnels and bridges
+	return (show_buildings && plan->get_kartenboden()->get_typ() == grund_t::fundament)?
+		plan->get_kartenboden() : plan->get_boden_bei(plan->get_boden_count() - 1);
+}
+
+
+void minimap_t::calc_tile_layers(const koord k, tile_max_t &max)
+{
+	const uint32 idx = get_tile_index(k);
+	uint8 &ground_flags = ground_layer->flags[idx];
+	uint8 &overlay_flags = current_overlay->flags[idx];
+	if(  (ground_flags & overlay_flags & LAYER_VALID)  ) {
 		return;
 	}
 
 	// always use to uppermost ground
 	const planquadrat_t *plan=world->access(k);
 	if(plan==nullptr  ||  plan->get_boden_count()==0) {
+		ground_layer->colors[idx] = color_idx_to_rgb(COL_BLACK);
+		ground_flags |= LAYER_VALID;
+		overlay_flags = LAYER_VALID;
 		return;
 	}
-	// When displaying buildings, give priority to buildings over tunnels and bridges
-	const grund_t *gr = (show_buildings && plan->get_kartenboden()->get_typ() == grund_t::fundament)?
-		plan->get_kartenboden() : plan->get_boden_bei(plan->get_boden_count() - 1);
+	const grund_t *gr = get_map_ground(plan);
+
+	if(  (ground_flags & LAYER_VALID) == 0  ) {
+		ground_layer->colors[idx] = calc_ground_color(gr, show_contour, show_buildings);
+		ground_flags |= LAYER_VALID;
+	}
+	if(  (overlay_flags & LAYER_VALID) == 0  ) {
+		PIXVAL color;
+		overlay_flags = calc_overlay_color(plan, gr, color, max) ? (LAYER_VALID|LAYER_OPAQUE) : LAYER_VALID;
+		current_overlay->colors[idx] = color;
+	}
+}
+
 
-	if(  mode!=MAP_PAX_DEST  &&  gr->get_convoi_vehicle() && (mode & MAP_CONVOYS)) {
+void minimap_t::composite_tile(const koord k)
+{
+	const planquadrat_t *plan=world->access(k);
+	if(plan==nullptr  ||  plan->get_boden_count()==0) {
+		return;
+	}
+	if(  mode!=MAP_PAX_DEST  &&  (mode & MAP_CONVOYS)  &&  get_map_ground(plan)->get_convoi_vehicle()  ) {
 		set_map_color(k, COL_VEHICLE);
 		return;
 	}
+	const uint32 idx = get_tile_index(k);
+	set_map_color( k, (current_overlay->flags[idx] & LAYER_OPAQUE) ? current_overlay->colors[idx] : ground_layer->colors[idx] );
+}
 
-	// first use ground color
-	set_map_color( k, calc_ground_color(gr, show_contour, show_buildings) );
 
+bool minimap_t::calc_overlay_color(const planquadrat_t *plan, const grund_t *gr, PIXVAL &color, tile_max_t &max) const
+{
+	bool opaque = false;
+	color = 0;
 	bool any_suitable_stops = false;
 	uint16 min_tiles_to_halt = -1;
 	switch(mode& ~MAP_MODE_FLAGS) {
@@ -859,19 +945,15 @@ void minimap_t::calc_map_pixel(const koord k)
 				}
 				if (any_suitable_stops) {
 					uint16 sutation_coverage = show_only_freight_station ? world->get_settings().get_station_coverage_factories() : world->get_settings().get_station_coverage();
-					set_map_color(k, calc_severity_color(min_tiles_to_halt, sutation_coverage * 2));
+					color = calc_severity_color(min_tiles_to_halt, sutation_coverage * 2);
+					opaque = true;
 				}
 			}
 			break;
 
 		// show usage
 		case MAP_FREIGHT:
-			// need to init the maximum?
-			if(max_cargo==0) {
-				max_cargo = 1;
-				calc_map();
-			}
-			else if(  gr->hat_wege()  ) {
+			if(  gr->hat_wege()  ) {
 				// now calc again ...
 				sint32 cargo=0;
 
@@ -883,22 +965,18 @@ void minimap_t::calc_map_pixel(const koord k)
 					if(w) {
 						cargo += w->get_statistics(WAY_STAT_GOODS);
 					}
-					if(  cargo > max_cargo  ) {
-						max_cargo = cargo;
+					if(  cargo > max.cargo  ) {
+						max.cargo = cargo;
 					}
-					set_map_color(k, calc_severity_color_log(cargo, max_cargo));
+					color = calc_severity_color_log(cargo, max.cargo);
+					opaque = true;
 				}
 			}
 			break;
 
 		// show traffic (=convois/month)
 		case MAP_TRAFFIC:
-			// need to init the maximum?
-			if(  max_passed==0  ) {
-				max_passed = 1;
-				calc_map();
-			}
-			else if(gr->hat_wege()) {
+			if(gr->hat_wege()) {
 				// now calc again ...
 				sint32 passed=0;
 
@@ -909,10 +987,11 @@ void minimap_t::calc_map_pixel(const koord k)
 					if(  weg_t *w=gr->get_weg_nr(1)  ) {
 						passed += w->get_statistics(WAY_STAT_CONVOIS);
 					}
-					if(  passed > max_passed  ) {
-						max_passed = passed;
+					if(  passed > max.passed  ) {
+						max.passed = passed;
 					}
-					set_map_color(k, calc_severity_color_log( passed, max_passed ) );
+					color = calc_severity_color_log( passed, max.passed );
+					opaque = true;
 				}
 			}
 			break;
@@ -927,7 +1006,8 @@ void minimap_t::calc_map_pixel(const koord k)
 				const weg_t *way = gr->get_weg_nr(0);
 				condition_percent = way->get_condition_percent();
 				if (way->get_desc()->is_mothballed()) {
-					set_map_color(k, MAP_COL_NODATA);
+					color = MAP_COL_NODATA;
+					opaque = true;
 					break;
 				}
 				else if(const weg_t *second_way = gr->get_weg_nr(1))
@@ -935,7 +1015,8 @@ void minimap_t::calc_map_pixel(const koord k)
 					condition_percent = min(condition_percent, second_way->get_condition_percent());
 				}
 				const sint32 condition_percent_reciprocal = 100 - condition_percent;
-				set_map_color(k, calc_severity_color(condition_percent_reciprocal, 100));
+				color = calc_severity_color(condition_percent_reciprocal, 100);
+				opaque = true;
 			}
 
 			break;
@@ -951,7 +1032,8 @@ void minimap_t::calc_map_pixel(const koord k)
 					// Because it is possible for congestion to be >100% (as 100% merely means that traffic
 					// takes 100% longer than the uncongested time to traverse the tile), set the colour range
 					// based on a maximum of 250% to allow more granularity in congested places.
-					set_map_color(k, calc_severity_color(road->get_congestion_percentage(), 250));
+					color = calc_severity_color(road->get_congestion_percentage(), 250);
+					opaque = true;
 				}
 			}
 			break;
@@ -962,14 +1044,17 @@ void minimap_t::calc_map_pixel(const koord k)
 			if (gr->hat_weg(track_wt)) {
 				const schiene_t * sch = (const schiene_t *) (gr->get_weg(track_wt));
 				if(sch->is_electrified()) {
-					set_map_color(k, color_idx_to_rgb(COL_RED));
+					color = color_idx_to_rgb(COL_RED);
+					opaque = true;
 				}
 				else {
-					set_map_color(k, color_idx_to_rgb(COL_WHITE));
+					color = color_idx_to_rgb(COL_WHITE);
+					opaque = true;
 				}
 				// show signals
 				if(sch->has_sign()  ||  sch->has_signal()) {
-					set_map_color(k, color_idx_to_rgb(COL_YELLOW));
+					color = color_idx_to_rgb(COL_YELLOW);
+					opaque = true;
 				}
 			}
 			break;
@@ -978,12 +1063,14 @@ void minimap_t::calc_map_pixel(const koord k)
 		case MAX_SPEEDLIMIT:
 			{
 				if (gr->hat_wege() && gr->get_weg_nr(0)->get_desc()->is_mothballed()) {
-					set_map_color(k, MAP_COL_NODATA);
+					color = MAP_COL_NODATA;
+					opaque = true;
 					break;
 				}
 				const sint32 speed_factor = 450-gr->get_max_speed() > 0 ? 450 - gr->get_max_speed() : 0;
 				if(gr->get_max_speed()) {
-					set_map_color(k, calc_severity_color(pow(speed_factor,2.0)/100, 2025));
+					color = calc_severity_color(pow(speed_factor,2.0)/100, 2025);
+					opaque = true;
 				}
 			}
 			break;
@@ -995,7 +1082,8 @@ void minimap_t::calc_map_pixel(const koord k)
 				{
 					const weg_t* way =  gr->get_weg_nr(0);
 					if (way->get_desc()->is_mothballed()) {
-						set_map_color(k, MAP_COL_NODATA);
+						color = MAP_COL_NODATA;
+						opaque = true;
 						break;
 					}
 					else if(way->get_waytype() == powerline_wt || !way->get_max_axle_load())
@@ -1004,11 +1092,13 @@ void minimap_t::calc_map_pixel(const koord k)
 					}
 					if(gr->ist_bruecke())
 					{
-						set_map_color(k, calc_severity_color(350-way->get_bridge_weight_limit()>0 ? 350-way->get_bridge_weight_limit() : 0, 350));
+						color = calc_severity_color(350-way->get_bridge_weight_limit()>0 ? 350-way->get_bridge_weight_limit() : 0, 350);
+						opaque = true;
 					}
 					else
 					{
-						set_map_color(k, calc_severity_color(30-way->get_max_axle_load()>0 ? 30-way->get_max_axle_load() : 0, 30));
+						color = calc_severity_color(30-way->get_max_axle_load()>0 ? 30-way->get_max_axle_load() : 0, 30);
+						opaque = true;
 					}
 				}
 			}
@@ -1021,10 +1111,12 @@ void minimap_t::calc_map_pixel(const koord k)
 				if(lt!=nullptr) {
 					const uint64 demand = lt->get_net()->get_demand();
 					if (!lt->get_net()->get_demand() || !lt->get_net()->get_supply()) {
-						set_map_color(k, MAP_COL_NODATA);
+						color = MAP_COL_NODATA;
+						opaque = true;
 					}
 					else if (demand) {
-						set_map_color(k, calc_severity_color((sint32)lt->get_net()->get_demand(), (sint32)lt->get_net()->get_supply()));
+						color = calc_severity_color((sint32)lt->get_net()->get_demand(), (sint32)lt->get_net()->get_supply());
+						opaque = true;
 					}
 				}
 			}
@@ -1032,7 +1124,8 @@ void minimap_t::calc_map_pixel(const koord k)
 
 		case MAP_FOREST:
 			if(  gr->get_top()>1  &&  gr->obj_bei(gr->get_top()-1)->get_typ()==obj_t::baum  ) {
-				set_map_color(k, color_idx_to_rgb(COL_GREEN) );
+				color = color_idx_to_rgb(COL_GREEN);
+				opaque = true;
 			}
 			break;
 
@@ -1040,33 +1133,32 @@ void minimap_t::calc_map_pixel(const koord k)
 			// show ownership
 			{
 				if(  gr->is_halt()  ) {
-					set_map_color(k, color_idx_to_rgb(gr->get_halt()->get_owner()->get_player_color1()+3));
+					color = color_idx_to_rgb(gr->get_halt()->get_owner()->get_player_color1()+3);
+					opaque = true;
 				}
 				else if(  weg_t *weg = gr->get_weg_nr(0)  ) {
-					set_map_color(k, color_idx_to_rgb(weg->get_owner()==nullptr ? COL_ORANGE : weg->get_owner()->get_player_color1()+3 ));
+					color = color_idx_to_rgb(weg->get_owner()==nullptr ? COL_ORANGE : weg->get_owner()->get_player_color1()+3 );
+					opaque = true;
 				}
 				if(  gebaeude_t *gb = gr->get_building()  ) {
 					if(  gb->get_owner()!=nullptr  ) {
-						set_map_color(k, color_idx_to_rgb(gb->get_owner()->get_player_color1()+3) );
+						color = color_idx_to_rgb(gb->get_owner()->get_player_color1()+3);
+						opaque = true;
 					}
 				}
 				break;
 			}
 
 		case MAP_LEVEL:
-			if(  max_building_level == 0  ) {
-				// init maximum
-				max_building_level = 1;
-				calc_map();
-			}
-			else if(  gr->get_typ() == grund_t::fundament  ) {
+			if(  gr->get_typ() == grund_t::fundament  ) {
 				if(  gebaeude_t *gb = gr->find<gebaeude_t>()  ) {
 					if(  gb->is_city_building()  ) {
 						sint32 level = gb->get_tile()->get_desc()->get_level();
-						if(  level > max_building_level  ) {
-							max_building_level = level;
+						if(  level > max.building_level  ) {
+							max.building_level = level;
 						}
-						set_map_color(k, calc_severity_color(level, max_building_level));
+						color = calc_severity_color(level, max.building_level);
+						opaque = true;
 					}
 				}
 			}
@@ -1079,10 +1171,12 @@ void minimap_t::calc_map_pixel(const koord k)
 					if (gb->get_adjusted_population()) {
 						const uint16 passengers_succeeded_commuting = gb->get_average_passenger_success_percent_commuting();
 						if(passengers_succeeded_commuting < 65535){
-							set_map_color(k, calc_severity_color(100 - passengers_succeeded_commuting, 100));
+							color = calc_severity_color(100 - passengers_succeeded_commuting, 100);
+							opaque = true;
 						}
 						else {
-							set_map_color(k, MAP_COL_NODATA);
+							color = MAP_COL_NODATA;
+							opaque = true;
 						}
 					}
 				}
@@ -1096,10 +1190,12 @@ void minimap_t::calc_map_pixel(const koord k)
 					if (gb->get_adjusted_population()) {
 						const uint16 passengers_succeeded_visiting = gb->get_average_passenger_success_percent_visiting();
 						if (passengers_succeeded_visiting < 65535) {
-							set_map_color(k, calc_severity_color(100 - passengers_succeeded_visiting, 100));
+							color = calc_severity_color(100 - passengers_succeeded_visiting, 100);
+							opaque = true;
 						}
 						else {
-							set_map_color(k, MAP_COL_NODATA);
+							color = MAP_COL_NODATA;
+							opaque = true;
 						}
 					}
 				}
@@ -1116,21 +1212,25 @@ void minimap_t::calc_map_pixel(const koord k)
 							const uint32 input_count = fab->get_input().get_count();
 							// Factories not in operation
 							if (gb->get_passengers_succeeded_commuting() == 65535 && input_count) {
-								set_map_color(k, color_idx_to_rgb(COL_DARK_PURPLE));
+								color = color_idx_to_rgb(COL_DARK_PURPLE);
+								opaque = true;
 							}
 							else {
 								const sint32 staffing_percentage = gb->get_staffing_level_percentage();
 								if (staffing_percentage < 65535) {
-									set_map_color(k, calc_severity_color(100 - staffing_percentage, 100));
+									color = calc_severity_color(100 - staffing_percentage, 100);
+									opaque = true;
 								}
 								else {
-									set_map_color(k, MAP_COL_NODATA);
+									color = MAP_COL_NODATA;
+									opaque = true;
 								}
 							}
 						}
 						else {
 							const sint32 staffing_percentage = gb->get_staffing_level_percentage();
-							set_map_color(k, calc_severity_color(100 - staffing_percentage, 100));
+							color = calc_severity_color(100 - staffing_percentage, 100);
+							opaque = true;
 						}
 					}
 
@@ -1145,10 +1245,12 @@ void minimap_t::calc_map_pixel(const koord k)
 					if (gb->get_adjusted_mail_demand()) {
 						const uint16 recent_mail_delivery_success_per = gb->get_average_mail_delivery_success_percent();
 						if (recent_mail_delivery_success_per < 65535) {
-							set_map_color(k, calc_severity_color(100 - recent_mail_delivery_success_per, 100));
+							color = calc_severity_color(100 - recent_mail_delivery_success_per, 100);
+							opaque = true;
 						}
 						else {
-							set_map_color(k, MAP_COL_NODATA);
+							color = MAP_COL_NODATA;
+							opaque = true;
 						}
 					}
 				}
@@ -1158,6 +1260,7 @@ void minimap_t::calc_map_pixel(const koord k)
 		default:
 			break;
 	}
+	return opaque;
 }
 
 
@@ -1186,6 +1289,212 @@ void minimap_t::calc_map_size()
 }
 
 
+minimap_t::tile_layer_t::tile_layer_t(uint32 count, uint32 key) :
+	key(key),
+	last_used(0)
+{
+	colors = new PIXVAL[count];
+	flags = new uint8[count];
+	memset( flags, 0, count );
+}
+
+
+minimap_t::tile_layer_t::~tile_layer_t()
+{
+	delete [] colors;
+	delete [] flags;
+}
+
+
+void minimap_t::free_layers()
+{
+	delete ground_layer;
+	ground_layer = nullptr;
+	clear_ptr_vector( overlay_layers );
+	current_overlay = nullptr;
+	pending_tiles.clear();
+}
+
+
+void minimap_t::invalidate_layers()
+{
+	if(  ground_layer  ) {
+		const uint32 count = (uint32)layer_size.x * layer_size.y;
+		memset( ground_layer->flags, 0, count );
+		FOR(vector_tpl<tile_layer_t*>, const layer, overlay_layers) {
+			memset( layer->flags, 0, count );
+		}
+		// the pending flags were cleared too
+		pending_tiles.clear();
+	}
+}
+
+
+void minimap_t::select_overlay_layer()
+{
+	if(  ground_layer  &&  layer_size != world->get_size()  ) {
+		free_layers();
+	}
+	const uint32 count = max( 1, (sint32)world->get_size().x * world->get_size().y );
+	if(  ground_layer == nullptr  ) {
+		layer_size = world->get_size();
+		ground_layer = new tile_layer_t( count, 0 );
+	}
+
+	const uint32 key = mode & ~MAP_MODE_FLAGS;
+	static uint32 use_counter = 0;
+	use_counter++;
+	FOR(vector_tpl<tile_layer_t*>, const layer, overlay_layers) {
+		if(  layer->key == key  ) {
+			layer->last_used = use_counter;
+			current_overlay = layer;
+			return;
+		}
+	}
+
+	// as many overlays as fit into the budget, but at least the current one
+	const uint32 bytes_per_layer = count * (sizeof(PIXVAL) + 1);
+	const uint32 max_overlays = clamp( (sint32)(MAX_LAYER_BYTES / bytes_per_layer) - 1, 1, (sint32)MAX_OVERLAY_LAYERS );
+	while(  overlay_layers.get_count() >= max_overlays  ) {
+		// drop the least recently used one
+		uint32 oldest = 0;
+		for(  uint32 i = 1;  i < overlay_layers.get_count();  i++  ) {
+			if(  overlay_layers[i]->last_used < overlay_layers[oldest]->last_used  ) {
+				oldest = i;
+			}
+		}
+		delete overlay_layers[oldest];
+		overlay_layers.remove_at( oldest );
+	}
+	current_overlay = new tile_layer_t( count, key );
+	current_overlay->last_used = use_counter;
+	overlay_layers.append( current_overlay );
+}
+
+
+void minimap_t::calc_layer_rows(koord start, koord end, sint16 step, tile_max_t &max)
+{
+	koord k;
+	for(  k.y=start.y;  k.y<end.y;  k.y+=step  ) {
+		for(  k.x=start.x;  k.x<end.x;  k.x+=step  ) {
+			calc_tile_layers( k, max );
+		}
+	}
+}
+
+
+#ifdef MULTI_THREAD
+struct minimap_thread_param_t {
+	minimap_t *map;
+	koord start, end;
+	sint16 step;
+	minimap_t::tile_max_t max;
+};
+
+
+void *minimap_t::calc_layer_rows_thread(void *ptr)
+{
+	minimap_thread_param_t *param = reinterpret_cast<minimap_thread_param_t *>(ptr);
+	param->map->calc_layer_rows( param->start, param->end, param->step, param->max );
+	return NULL;
+}
+#endif
+
+
+void minimap_t::calc_layers(koord start, koord end, sint16 step)
+{
+	// the scales must be known before, since the tiles are computed in any order
+	if(  (mode & MAP_FREIGHT)  &&  max_cargo == 0  ) {
+		// start with the busiest single way, so the colours hardly shift
+		max_cargo = max( 1, weg_t::get_max_statistics(WAY_STAT_GOODS) );
+	}
+	if(  (mode & MAP_TRAFFIC)  &&  max_passed == 0  ) {
+		max_passed = max( 1, weg_t::get_max_statistics(WAY_STAT_CONVOIS) );
+	}
+	if(  (mode & MAP_LEVEL)  &&  max_building_level == 0  ) {
+		max_building_level = 1;
+	}
+
+	for(  int pass = 0;  pass < 2;  pass++  ) {
+		tile_max_t max;
+		max.cargo = max_cargo;
+		max.passed = max_passed;
+		max.building_level = max_building_level;
+
+#ifdef MULTI_THREAD
+		const sint32 rows = (end.y - start.y + step - 1) / step;
+		const sint32 tiles = rows * ((end.x - start.x + step - 1) / step);
+		const sint32 num_threads = min( (sint32)env_t::num_threads, min( rows, tiles / MIN_TILES_PER_THREAD ) );
+		if(  num_threads > 1  ) {
+			minimap_thread_param_t param[MAX_THREADS];
+			pthread_t thread[MAX_THREADS];
+			for(  sint32 t = 0;  t < num_threads;  t++  ) {
+				param[t].map = this;
+				param[t].start = koord( start.x, start.y + (sint16)(((t * rows) / num_threads) * step) );
+				param[t].end = koord( end.x, min( end.y, start.y + (sint16)((((t + 1) * rows) / num_threads) * step) ) );
+				param[t].step = step;
+				param[t].max = max;
+				if(  t < num_threads - 1  &&  pthread_create( &thread[t], NULL, calc_layer_rows_thread, &param[t] )  ) {
+					dbg->fatal( "minimap_t::calc_layers()", "cannot multithread, error at thread #%i", t+1 );
+				}
+			}
+			// the last band we do ourselves
+			calc_layer_rows( param[num_threads - 1].start, param[num_threads - 1].end, step, param[num_threads - 1].max );
+			for(  sint32 t = 0;  t < num_threads;  t++  ) {
+				if(  t < num_threads - 1  ) {
+					pthread_join( thread[t], NULL );
+				}
+				max.cargo = ::max( max.cargo, param[t].max.cargo );
+				max.passed = ::max( max.passed, param[t].max.passed );
+				max.building_level = ::max( max.building_level, param[t].max.building_level );
+			}
+		}
+		else
+#endif
+		{
+			calc_layer_rows( start, end, step, max );
+		}
+
+		if(  max.cargo == max_cargo  &&  max.passed == max_passed  &&  max.building_level == max_building_level  ) {
+			break;
+		}
+		// a scale grew: colour this area again with the final scale
+		max_cargo = max.cargo;
+		max_passed = max.passed;
+		max_building_level = max.building_level;
+		koord k;
+		for(  k.y=start.y;  k.y<end.y;  k.y+=step  ) {
+			for(  k.x=start.x;  k.x<end.x;  k.x+=step  ) {
+				current_overlay->flags[get_tile_index(k)] &= ~LAYER_VALID;
+			}
+		}
+	}
+}
+
+
+void minimap_t::update_pending_tiles()
+{
+	if(  pending_tiles.empty()  ) {
+		return;
+	}
+	tile_max_t max;
+	max.cargo = max_cargo;
+	max.passed = max_passed;
+	max.building_level = max_building_level;
+	FOR(vector_tpl<koord>, const k, pending_tiles) {
+		ground_layer->flags[get_tile_index(k)] &= ~LAYER_PENDING;
+		if(  view_start.x <= k.x  &&  k.x < view_end.x  &&  view_start.y <= k.y  &&  k.y < view_end.y  ) {
+			calc_tile_layers( k, max );
+			composite_tile( k );
+		}
+	}
+	pending_tiles.clear();
+	max_cargo = max.cargo;
+	max_passed = max.passed;
+	max_building_level = max.building_level;
+}
+
+
 void minimap_t::calc_map()
 {
 	// only use bitmap size like screen size
@@ -1200,24 +1509,54 @@ void minimap_t::calc_map()
 	needs_redraw = false;
 	is_visible = true;
 
-	// redraw the map
+	select_overlay_layer();
+	// everything visible is redrawn below
+	FOR(vector_tpl<koord>, const k, pending_tiles) {
+		ground_layer->flags[get_tile_index(k)] &= ~LAYER_PENDING;
+	}
+	pending_tiles.clear();
+
+	// the tiles with pixels in the visible part
+	sint16 step = 1;
 	if(  !isometric  ) {
-		koord k;
-		koord start_off = koord( (cur_off.x*zoom_out)/zoom_in, (cur_off.y*zoom_out)/zoom_in );
-		koord end_off = start_off+koord( ( map_data->get_width()*zoom_out)/zoom_in+1, ( map_data->get_height()*zoom_out)/zoom_in+1 );
-		for(  k.y=start_off.y;  k.y<end_off.y;  k.y+=zoom_out  ) {
-			for(  k.x=start_off.x;  k.x<end_off.x;  k.x+=zoom_out  ) {
-				calc_map_pixel(k);
-			}
-		}
+		view_start = koord( (cur_off.x*zoom_out)/zoom_in, (cur_off.y*zoom_out)/zoom_in );
+		view_end = view_start+koord( ( map_data->get_width()*zoom_out)/zoom_in+1, ( map_data->get_height()*zoom_out)/zoom_in+1 );
+		step = zoom_out;
 	}
 	else {
-		// always the whole map ...
-        map_data->init( color_idx_to_rgb(COL_BLACK) );
+		// bounding box of the rotated window, with a margin for the size of a tile
+		map_data->init( color_idx_to_rgb(COL_BLACK) );
+		const koord corner[4] = {
+			screen_to_map_coord( cur_off ),
+			screen_to_map_coord( cur_off + scr_coord( map_data->get_width(), 0 ) ),
+			screen_to_map_coord( cur_off + scr_coord( 0, map_data->get_height() ) ),
+			screen_to_map_coord( cur_off + scr_coord( map_data->get_width(), map_data->get_height() ) )
+		};
+		view_start = view_end = corner[0];
+		for(  int i = 1;  i < 4;  i++  ) {
+			view_start.clip_max( corner[i] );
+			view_end.clip_min( corner[i] );
+		}
+		const sint16 margin = 2 + 2*zoom_out;
+		view_start -= koord( margin, margin );
+		view_end += koord( margin+1, margin+1 );
+	}
+	// keep the sampling grid of the zoomed out map when clipping
+	if(  view_start.x < 0  ) {
+		view_start.x += ((-view_start.x + step - 1) / step) * step;
+	}
+	if(  view_start.y < 0  ) {
+		view_start.y += ((-view_start.y + step - 1) / step) * step;
+	}
+	view_end.clip_max( world->get_size() );
+
+	// colour the tiles (in parallel), then draw them in order, since tiles overlap in isometric view
+	if(  view_start.x < view_end.x  &&  view_start.y < view_end.y  ) {
+		calc_layers( view_start, view_end, step );
 		koord k;
-		for(  k.y=0;  k.y < world->get_size().y;  k.y++  ) {
-			for(  k.x=0;  k.x < world->get_size().x;  k.x++  ) {
-				calc_map_pixel(k);
+		for(  k.y=view_start.y;  k.y<view_end.y;  k.y+=step  ) {
+			for(  k.x=view_start.x;  k.x<view_end.x;  k.x+=step  ) {
+				composite_tile(k);
 			}
 		}
 	}
@@ -1306,6 +1645,7 @@ void minimap_t::init()
 void minimap_t::finalize(){
 	delete map_data;
 	map_data = nullptr;
+	free_layers();
 }
 
 
@@ -1318,6 +1658,15 @@ void minimap_t::set_display_mode(MAP_DISPLAY_MODE new_mode)
 
 void minimap_t::new_month()
 {
+	// the statistics changed everywhere
+	invalidate_layers();
+	needs_redraw = true;
+}
+
+
+void minimap_t::rotate90()
+{
+	invalidate_layers();
 	needs_redraw = true;
 }
 
@@ -1325,6 +1674,8 @@ void minimap_t::new_month()
 void minimap_t::invalidate_map_lines_cache()
 {
 	last_schedule_counter = world->get_schedule_counter() - 1;
+	// filters or the ground display may have changed
+	invalidate_layers();
 	needs_redraw = true;
 }
 
@@ -1465,6 +1816,8 @@ void minimap_t::draw(scr_coord pos)
 		return;
 	}
 
+	update_pending_tiles();
+
 	if(  mode & MAP_PAX_DEST  &&  selected_city!=NULL  ) {
 		const uint32 current_pax_destinations = selected_city->get_pax_destinations_new_change();
 		if(  pax_destinations_last_change > current_pax_destinations  ) {
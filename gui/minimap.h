@@ -17,6 +17,7 @@
 
 
 class karte_ptr_t;
+class planquadrat_t;
 class fabrik_t;
 class grund_t;
 class stadt_t;
@@ -74,6 +75,13 @@ public:
 		MAP_MODE_FLAGS = (MAP_TOWN|MAP_CITYLIMIT|MAP_SERVICE|MAP_PAX_WAITING|MAP_MAIL_WAITING|MAP_GOODS_WAITING|MAP_TRANSFER|MAP_LINES|MAP_FACTORIES|MAP_ORIGIN|MAP_DEPOT|MAP_TOURIST|MAP_CONVOYS|MAP_MAIL_HANDLING_VOLUME|MAP_GOODS_HANDLING_VOLUME)
 	};
 
+	/// scales of the overlays that grow while colouring
+	struct tile_max_t {
+		sint32 cargo;
+		sint32 passed;
+		sint32 building_level;
+	};
+
 private:
 	//This one really has to be static
 	static minimap_t *single_instance;
@@ -175,6 +183,67 @@ private:
 	/// true, if full redraw is needed
 	bool needs_redraw{true};
 
+	/**
+	 * Colours of all tiles for the ground or for the overlay of one mode.
+	 * They are computed when they come into view and stay valid until the
+	 * tile changes, so scrolling or switching back to a mode only composes
+	 * the layers again.
+	 */
+	class tile_layer_t
+	{
+	public:
+		tile_layer_t(uint32 count, uint32 key);
+		~tile_layer_t();
+
+		uint32 key;       ///< display mode without flags, for overlays
+		uint32 last_used;
+		PIXVAL *colors;
+		uint8 *flags;
+	};
+
+	enum {
+		LAYER_VALID   = 1,
+		LAYER_OPAQUE  = 2, ///< overlay hides the ground
+		LAYER_PENDING = 4, ///< ground layer only: in pending_tiles
+		MAX_OVERLAY_LAYERS = 4,
+		MIN_TILES_PER_THREAD = 4096
+	};
+	/// memory for the ground and the cached overlays
+	static const uint32 MAX_LAYER_BYTES = 128u << 20;
+
+	tile_layer_t *ground_layer{nullptr};
+	tile_layer_t *current_overlay{nullptr};
+	vector_tpl<tile_layer_t*> overlay_layers;
+
+	/// changed tiles, updated before the next draw
+	vector_tpl<koord> pending_tiles;
+
+	/// the tiles computed by the last calc_map()
+	koord view_start, view_end;
+
+	/// map size when the layers were allocated
+	koord layer_size;
+
+	uint32 get_tile_index(koord k) const;
+	bool is_in_layers(koord k) const;
+	const grund_t *get_map_ground(const planquadrat_t *plan) const;
+
+	void free_layers();
+	void invalidate_layers();
+	void select_overlay_layer();
+	void add_pending_tile(koord k);
+	void update_pending_tiles();
+
+	void calc_tile_layers(koord k, tile_max_t &max);
+	void calc_layer_rows(koord start, koord end, sint16 step, tile_max_t &max);
+	static void *calc_layer_rows_thread(void *param);
+	/// computes the invalid tiles in the rectangle, in parallel if worth it
+	void calc_layers(koord start, koord end, sint16 step);
+	void composite_tile(koord k);
+
+	/// @return true if the current mode shows something else than the ground on this tile
+	bool calc_overlay_color(const planquadrat_t *plan, const grund_t *gr, PIXVAL &color, tile_max_t &max) const;
+
 	const fabrik_t* get_factory_near(koord pos, bool large_area) const;
 
 	const fabrik_t* draw_factory_connections(const fabrik_t* const fab, bool supplier_link, const scr_coord pos) const;
@@ -238,9 +307,12 @@ public:
 		new_size = size;
 	}
 
-	/// update color with render mode (but few are ignored ... )
+	/// the tile changed: its colour is updated before the next draw
 	void calc_map_pixel(koord k);
 
+	/// only the convoys on the tile changed
+	void calc_convoy_pixel(koord k);
+
 	void calc_map();
 
 	/// calculates the current size of the map (but do not change anything else)
@@ -259,6 +331,9 @@ public:
 	/// updates the map (if needed)
 	void new_month();
 
+	/// the cached colours belong to the old orientation
+	void rotate90();
+
 	void invalidate_map_lines_cache();
 
 	bool infowin_event(event_t const*) OVERRIDE;
@@ -0,0 +1,115 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "step_profiler_frame.h"
+#include "messagebox.h"
+#include "simwin.h"
+#include "components/gui_divider.h"
+
+#include "../dataobj/translator.h"
+#include "../sys/simsys.h"
+
+
+#define STEP_PROFILE_CSV  "step_profile.csv"
+#define STEP_PROFILE_JSON "step_profile.json"
+
+
+step_profiler_frame_t::step_profiler_frame_t() :
+	gui_frame_t( translator::translate("Step profiler") ),
+	last_update(0)
+{
+	set_table_layout(1,0);
+
+	add_component(&lb_steps);
+
+	add_table(COLUMNS+1,0);
+	{
+		static const char *const head[COLUMNS] = { "last ms", "avg ms", "95% ms", "max ms" };
+		new_component<gui_label_t>("Phase");
+		for(  int c = 0;  c < COLUMNS;  c++  ) {
+			new_component<gui_label_t>(head[c], SYSCOL_TEXT, gui_label_t::right);
+		}
+
+		const scr_coord_val width = proportional_string_width("00000.00");
+		for(  int p = 0;  p < MAX_STEP_PHASES;  p++  ) {
+			const step_phase_t phase = (step_phase_t)p;
+			gui_label_buf_t *lb = new_component<gui_label_buf_t>();
+			for(  uint8 d = 0;  d < step_profiler_t::get_depth(phase);  d++  ) {
+				lb->buf().append("    ");
+			}
+			lb->buf().append(translator::translate(step_profiler_t::get_name(phase)));
+			lb->update();
+			for(  int c = 0;  c < COLUMNS;  c++  ) {
+				lb_times[p][c].init(SYSCOL_TEXT, gui_label_t::right);
+				lb_times[p][c].set_fixed_width(width);
+				add_component(&lb_times[p][c]);
+			}
+		}
+	}
+	end_table();
+
+	new_component<gui_divider_t>();
+
+	add_table(2,1);
+	{
+		bt_csv.init(button_t::roundbox, "Export CSV");
+		bt_csv.add_listener(this);
+		add_component(&bt_csv);
+
+		bt_json.init(button_t::roundbox, "Export JSON");
+		bt_json.add_listener(this);
+		add_component(&bt_json);
+	}
+	end_table();
+
+	update_labels();
+
+	reset_min_windowsize();
+	set_windowsize(get_min_windowsize());
+}
+
+
+void step_profiler_frame_t::update_labels()
+{
+	lb_steps.buf().printf(translator::translate("Last %u steps"), step_profiler_t::get_steps());
+	lb_steps.update();
+
+	for(  int p = 0;  p < MAX_STEP_PHASES;  p++  ) {
+		const step_phase_t phase = (step_phase_t)p;
+		const uint64 times[COLUMNS] = {
+			step_profiler_t::get_last(phase),
+			step_profiler_t::get_average(phase),
+			step_profiler_t::get_percentile(phase, 95),
+			step_profiler_t::get_max(phase)
+		};
+		for(  int c = 0;  c < COLUMNS;  c++  ) {
+			lb_times[p][c].buf().printf("%.2f", times[c] / 1000.0);
+			lb_times[p][c].update();
+		}
+	}
+}
+
+
+void step_profiler_frame_t::draw(scr_coord pos, scr_size size)
+{
+	// twice a second is plenty
+	if(  dr_time() - last_update > 500  ) {
+		last_update = dr_time();
+		update_labels();
+	}
+	gui_frame_t::draw(pos, size);
+}
+
+
+bool step_profiler_frame_t::action_triggered(gui_action_creator_t *comp, value_t)
+{
+	const char *filename = comp == &bt_json ? STEP_PROFILE_JSON : STEP_PROFILE_CSV;
+	const bool ok = comp == &bt_json ? step_profiler_t::write_json(filename) : step_profiler_t::write_csv(filename);
+
+	cbuffer_t buf;
+	buf.printf(translator::translate(ok ? "Saved %s" : "Cannot write %s"), filename);
+	create_win(new news_img(buf), w_time_delete, magic_none);
+	return true;
+}
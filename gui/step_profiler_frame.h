@@ -0,0 +1,40 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef GUI_STEP_PROFILER_FRAME_H
+#define GUI_STEP_PROFILER_FRAME_H
+
+
+#include "gui_frame.h"
+#include "components/action_listener.h"
+#include "components/gui_button.h"
+#include "components/gui_label.h"
+#include "../utils/step_profiler.h"
+
+
+/**
+ * Shows the times of the phases of the world step (see step_profiler_t)
+ */
+class step_profiler_frame_t : public gui_frame_t, private action_listener_t
+{
+	enum { COLUMNS = 4 };
+
+	gui_label_buf_t lb_steps;
+	gui_label_buf_t lb_times[MAX_STEP_PHASES][COLUMNS];
+	button_t bt_csv, bt_json;
+
+	uint32 last_update;
+
+	void update_labels();
+
+public:
+	step_profiler_frame_t();
+
+	void draw(scr_coord pos, scr_size size) OVERRIDE;
+
+	bool action_triggered(gui_action_creator_t*, value_t) OVERRIDE;
+};
+
+#endif
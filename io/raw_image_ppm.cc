@@ -90,8 +90,39 @@ bool raw_image_t::read_ppm(const char *filename)
 }
 
 
-bool raw_image_t::write_ppm(const char *) const
+bool raw_image_t::write_ppm(const char *filename) const
 {
-	dbg->error("raw_image_t::write_ppm", "Not implemented");
-	return false;
+	if(  fmt == FMT_INVALID  ) {
+		dbg->error("raw_image_t::write_ppm", "Invalid format");
+		return false;
+	}
+
+#ifdef MAKEOBJ
+	FILE *file = fopen(filename, "wb");
+#else
+	FILE *file = dr_fopen(filename, "wb");
+#endif
+	if(  !file  ) {
+		return false;
+	}
+
+	// greyscale images are written as P5, all others as P6 (binary RGB)
+	fprintf(file, "%s\n%u %u\n255\n", fmt == FMT_GRAY8 ? "P5" : "P6", width, height);
+
+	for(  uint32 y=0;  y<height;  y++  ) {
+		const uint8 *row = access_pixel(0, y);
+		if(  fmt == FMT_RGBA8888  ) {
+			// drop the alpha channel
+			for(  uint32 x=0;  x<width;  x++  ) {
+				fwrite(row + x*4, 3, 1, file);
+			}
+		}
+		else {
+			fwrite(row, bpp/CHAR_BIT, width, file);
+		}
+	}
+
+	const bool ok = ferror(file) == 0;
+	fclose(file);
+	return ok;
 }
@@ -21,6 +21,7 @@
 #include "../boden/grund.h"
 #include "../boden/wege/strasse.h"
 
+#include "../dataobj/freelist.h"
 #include "../dataobj/loadsave.h"
 #include "../dataobj/scenario.h"
 #include "../dataobj/translator.h"
@@ -146,6 +147,18 @@ roadsign_t::roadsign_t(player_t *player, koord3d pos, ribi_t::ribi dir, const ro
 }
 
 
+void* roadsign_t::operator new(size_t s)
+{
+	return freelist_t::gimme_node(s);
+}
+
+
+void roadsign_t::operator delete(void* p, size_t s)
+{
+	freelist_t::putback_node(s, p);
+}
+
+
 roadsign_t::~roadsign_t()
 {
 	if(  desc  ) {
@@ -376,6 +389,17 @@ void roadsign_t::info(cbuffer_t & buf) const
 
 // could be still better aligned for drive_left settings ...
 // now only an offset in desc could improve it ...
+void roadsign_t::set_state(signal_aspects s)
+{
+	state = s;
+	calc_image();
+	if(  s == danger  &&  get_typ() == obj_t::signal  &&  ((signal_t *)this)->is_time_interval_queued()  ) {
+		// it may show caution at the next step
+		welt->time_interval_signal_set_to_danger( (signal_t *)this );
+	}
+}
+
+
 void roadsign_t::calc_image()
 {
 	set_flag(obj_t::dirty);
@@ -78,7 +78,7 @@ public:
 	*/
 	void set_dir(ribi_t::ribi dir);
 
-	void set_state(signal_aspects s) { state = s; calc_image(); }
+	void set_state(signal_aspects s);
 	signal_aspects get_state() const { return (signal_aspects)state; }
 
 #ifdef INLINE_OBJ_TYPE
@@ -527,6 +527,9 @@ public:
 			return "unknown";
 		};
 	}
+
+	void* operator new(size_t s);
+	void  operator delete(void* p, size_t s);
 };
 
 #endif
@@ -35,6 +35,8 @@ signal_t::signal_t( loadsave_t *file) :
 	roadsign_t(file)
 #endif
 {
+	time_interval_queued = false;
+	time_interval_due = 0;
 	rdwr_signal(file);
 	if(desc==NULL) {
 		desc = roadsign_t::default_signal;
@@ -59,6 +61,8 @@ signal_t::signal_t(player_t *player, koord3d pos, ribi_t::ribi dir,const roadsig
 
 	train_last_passed = 0;
 	no_junctions_to_next_signal = false;
+	time_interval_queued = false;
+	time_interval_due = 0;
 
 	if(desc->get_signal_group())
 	{
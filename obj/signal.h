@@ -24,6 +24,11 @@ private:
 
 	bool no_junctions_to_next_signal;
 
+	// Whether the world has a timer for this signal and when it is due,
+	// see karte_t::add_time_interval_signal_to_check()
+	bool time_interval_queued;
+	sint64 time_interval_due;
+
 	// Used for time interval signalling
 	sint64 train_last_passed;
 
@@ -66,6 +71,12 @@ public:
 	void set_train_last_passed(sint64 value) { train_last_passed = value; }
 	sint64 get_train_last_passed() const { return train_last_passed; }
 
+	void set_time_interval_queued(bool value) { time_interval_queued = value; }
+	bool is_time_interval_queued() const { return time_interval_queued; }
+
+	void set_time_interval_due(sint64 tick) { time_interval_due = tick; }
+	sint64 get_time_interval_due() const { return time_interval_due; }
+
 	void show_info() OVERRIDE;
 };
 
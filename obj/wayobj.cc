@@ -12,6 +12,7 @@
 #include "../player/simplay.h"
 #include "../simtool.h"
 
+#include "../dataobj/freelist.h"
 #include "../dataobj/loadsave.h"
 #include "../dataobj/ribi.h"
 #include "../dataobj/scenario.h"
@@ -77,6 +78,18 @@ wayobj_t::wayobj_t(koord3d const pos, player_t* const owner, ribi_t::ribi const
 }
 
 
+void* wayobj_t::operator new(size_t s)
+{
+	return freelist_t::gimme_node(s);
+}
+
+
+void wayobj_t::operator delete(void* p, size_t s)
+{
+	freelist_t::putback_node(s, p);
+}
+
+
 wayobj_t::~wayobj_t()
 {
 	if(!desc) {
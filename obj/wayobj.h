@@ -123,6 +123,9 @@ public:
 	static void fill_menu(tool_selector_t *tool_selector, waytype_t wtyp, sint16 sound_ok);
 
 	static stringhashtable_tpl<way_obj_desc_t *, N_BAGS_MEDIUM>* get_all_wayobjects() { return &table; }
+
+	void* operator new(size_t s);
+	void  operator delete(void* p, size_t s);
 };
 
 #endif
@@ -14,6 +14,7 @@
 #include "../../simhalt.h"
 #include "../../simline.h"
 #include "../../simworld.h"
+#include "../../player/simplay.h"
 #include "../../vehicle/vehicle.h"
 
 using namespace script_api;
@@ -91,6 +92,90 @@ SQInteger generic_get_convoy_by_index(HSQUIRRELVM vm)
 }
 
 
+static void push_convoy_id(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<uint16>::push(vm, cnv.get_id());
+}
+
+static void push_convoy_name(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<const char*>::push(vm, cnv->get_name());
+}
+
+static void push_convoy_owner(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<uint8>::push(vm, cnv->get_owner() ? cnv->get_owner()->get_player_nr() : PLAYER_UNOWNED);
+}
+
+static void push_convoy_waytype(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<waytype_t>::push(vm, get_convoy_wt(cnv.get_rep()));
+}
+
+static void push_convoy_pos(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<koord3d>::push(vm, cnv->get_pos());
+}
+
+static void push_convoy_line_id(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<uint16>::push(vm, cnv->get_line().get_id());
+}
+
+static void push_convoy_distance_traveled_total(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<sint64>::push(vm, cnv->get_total_distance_traveled());
+}
+
+/// value of the current month, like index [0] of get_convoy_stat
+template<int INDEX> static void push_convoy_stat(HSQUIRRELVM vm, convoihandle_t const& cnv)
+{
+	param<sint64>::push(vm, cnv->get_stat_converted(0, (convoi_t::convoi_cost_t)INDEX));
+}
+
+static const bulk_field_t<convoihandle_t> convoy_fields[] = {
+	{ "id",                          push_convoy_id },
+	{ "name",                        push_convoy_name },
+	{ "owner",                       push_convoy_owner },
+	{ "waytype",                     push_convoy_waytype },
+	{ "pos",                         push_convoy_pos },
+	{ "line_id",                     push_convoy_line_id },
+	{ "distance_traveled_total",     push_convoy_distance_traveled_total },
+	{ "capacity",                    push_convoy_stat<convoi_t::CONVOI_CAPACITY> },
+	{ "transported_goods",           push_convoy_stat<convoi_t::CONVOI_PAX_DISTANCE> },
+	{ "revenue",                     push_convoy_stat<convoi_t::CONVOI_REVENUE> },
+	{ "cost",                        push_convoy_stat<convoi_t::CONVOI_OPERATIONS> },
+	{ "profit",                      push_convoy_stat<convoi_t::CONVOI_PROFIT> },
+	{ "traveled_distance",           push_convoy_stat<convoi_t::CONVOI_DISTANCE> }
+};
+
+
+SQInteger generic_get_convoy_data(HSQUIRRELVM vm)
+{
+	vector_tpl<convoihandle_t> const* list = generic_get_convoy_list(vm, 1);
+	if (list == NULL) {
+		return SQ_ERROR;
+	}
+	player_t *owner = NULL;
+	if (sq_gettype(vm, 2) != OT_NULL) {
+		// null selects all owners, but an invalid player must not
+		owner = param<player_t*>::get(vm, 2);
+		if (owner == NULL) {
+			return sq_raise_error(vm, "Invalid player");
+		}
+	}
+	waytype_t wt = param<waytype_t>::get(vm, 3);
+
+	vector_tpl<convoihandle_t> selected(list->get_count());
+	FOR(vector_tpl<convoihandle_t>, const cnv, *list) {
+		if (cnv.is_bound()  &&  (owner == NULL  ||  cnv->get_owner() == owner)  &&  (wt == invalid_wt  ||  get_convoy_wt(cnv.get_rep()) == wt)) {
+			selected.append(cnv);
+		}
+	}
+	return push_bulk_fields(vm, 4, selected, convoy_fields);
+}
+
+
 void export_convoy(HSQUIRRELVM vm)
 {
 	/**
@@ -122,6 +207,30 @@ void export_convoy(HSQUIRRELVM vm)
 	 * @typemask integer()
 	 */
 	register_function(vm, generic_get_convoy_count, "get_count",  1, "x");
+	/**
+	 * Returns fields of all convoys in the list, which belong to a player
+	 * and have a waytype, in one call. This is much faster than to
+	 * iterate through the list and call the methods of convoy_x.
+	 *
+	 * Usage:
+	 * @code
+	 * local data = world.get_convoy_list().get_data(player_x(2), wt_rail, ["id", "profit"])
+	 * for(local i = 0; i < data.id.len(); i++) {
+	 *     ... // data.profit[i] is the profit of convoy_x(data.id[i]) this month
+	 * }
+	 * @endcode
+	 *
+	 * Known fields: id, name, owner (player number), waytype, pos, line_id (0 if none),
+	 * distance_traveled_total, and the values of this month of capacity,
+	 * transported_goods, revenue, cost, profit, traveled_distance.
+	 *
+	 * @param owner only convoys of this player, or null for all (an invalid player raises an error)
+	 * @param wt only convoys of this waytype, or wt_all
+	 * @param fields array with the names of the fields
+	 * @returns table with one array per field, all in the order of the list
+	 * @typemask table(player_x,way_types,array<string>)
+	 */
+	register_function(vm, generic_get_convoy_data, "get_data",  4, "x t|x|y|o i a");
 
 	end_class(vm);
 
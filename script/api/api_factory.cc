@@ -128,6 +128,43 @@ SQInteger world_get_factory_by_index(HSQUIRRELVM vm)
 }
 
 
+static void push_factory_name(HSQUIRRELVM vm, fabrik_t* const& fab)
+{
+	param<const char*>::push(vm, fab->get_name());
+}
+
+static void push_factory_pos(HSQUIRRELVM vm, fabrik_t* const& fab)
+{
+	param<koord>::push(vm, fab->get_pos().get_2d());
+}
+
+/// value of the current month, like index [0] of get_factory_stat
+template<int INDEX> static void push_factory_stat(HSQUIRRELVM vm, fabrik_t* const& fab)
+{
+	param<sint64>::push(vm, fab->get_stat_converted(0, INDEX));
+}
+
+static const bulk_field_t<fabrik_t*> factory_fields[] = {
+	{ "name",            push_factory_name },
+	{ "pos",             push_factory_pos },
+	{ "production",      push_factory_stat<FAB_PRODUCTION> },
+	{ "power",           push_factory_stat<FAB_POWER> },
+	{ "boost_electric",  push_factory_stat<FAB_BOOST_ELECTRIC> },
+	{ "boost_pax",       push_factory_stat<FAB_BOOST_PAX> },
+	{ "boost_mail",      push_factory_stat<FAB_BOOST_MAIL> },
+	{ "pax_arrived",     push_factory_stat<FAB_PAX_ARRIVED> },
+	{ "mail_departed",   push_factory_stat<FAB_MAIL_DEPARTED> },
+	{ "mail_arrived",    push_factory_stat<FAB_MAIL_ARRIVED> },
+	{ "visitor_arrived", push_factory_stat<FAB_CONSUMER_ARRIVED> }
+};
+
+
+SQInteger world_get_factory_data(HSQUIRRELVM vm)
+{
+	return push_bulk_fields(vm, 2, welt->get_fab_list(), factory_fields);
+}
+
+
 void export_factory(HSQUIRRELVM vm)
 {
 	/**
@@ -150,6 +187,25 @@ void export_factory(HSQUIRRELVM vm)
 	 * Meta-method to be used in foreach loops. Do not call them directly.
 	 */
 	register_function(vm, world_get_factory_by_index, "_get",    2, "xi");
+	/**
+	 * Returns fields of all factories in one call. This is much faster than
+	 * to iterate through the list and call the methods of factory_x.
+	 *
+	 * Usage:
+	 * @code
+	 * local data = factory_list_x().get_data(["pos", "production"])
+	 * // data.production[i] is the production of the factory at data.pos[i] this month
+	 * @endcode
+	 *
+	 * Known fields: name, pos, and the values of this month of production,
+	 * power, boost_electric, boost_pax, boost_mail, pax_arrived,
+	 * mail_departed, mail_arrived, visitor_arrived.
+	 *
+	 * @param fields array with the names of the fields
+	 * @returns table with one array per field, all in the order of the list
+	 * @typemask table(array<string>)
+	 */
+	register_function(vm, world_get_factory_data,     "get_data", 2, "xa");
 
 	end_class(vm);
 
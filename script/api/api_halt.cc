@@ -13,6 +13,7 @@
 #include "../api_class.h"
 #include "../api_function.h"
 #include "../../simhalt.h"
+#include "../../player/simplay.h"
 
 namespace script_api {
 
@@ -56,6 +57,71 @@ SQInteger world_get_halt_by_index(HSQUIRRELVM vm)
 }
 
 
+static void push_halt_id(HSQUIRRELVM vm, halthandle_t const& halt)
+{
+	param<uint16>::push(vm, halt.get_id());
+}
+
+static void push_halt_name(HSQUIRRELVM vm, halthandle_t const& halt)
+{
+	param<const char*>::push(vm, halt->get_name());
+}
+
+static void push_halt_owner(HSQUIRRELVM vm, halthandle_t const& halt)
+{
+	param<uint8>::push(vm, halt->get_owner() ? halt->get_owner()->get_player_nr() : PLAYER_UNOWNED);
+}
+
+static void push_halt_pos(HSQUIRRELVM vm, halthandle_t const& halt)
+{
+	param<koord3d>::push(vm, halt->get_basis_pos3d());
+}
+
+/// value of the current month, like index [0] of get_halt_stat
+template<int INDEX> static void push_halt_stat(HSQUIRRELVM vm, halthandle_t const& halt)
+{
+	param<sint64>::push(vm, halt->get_finance_history(0, INDEX));
+}
+
+static const bulk_field_t<halthandle_t> halt_fields[] = {
+	{ "id",          push_halt_id },
+	{ "name",        push_halt_name },
+	{ "owner",       push_halt_owner },
+	{ "pos",         push_halt_pos },
+	{ "visitors",    push_halt_stat<HALT_VISITORS> },
+	{ "commuters",   push_halt_stat<HALT_COMMUTERS> },
+	{ "waiting",     push_halt_stat<HALT_WAITING> },
+	{ "happy",       push_halt_stat<HALT_HAPPY> },
+	{ "unhappy",     push_halt_stat<HALT_UNHAPPY> },
+	{ "noroute",     push_halt_stat<HALT_NOROUTE> },
+	{ "convoys",     push_halt_stat<HALT_CONVOIS_ARRIVED> },
+	{ "too_slow",    push_halt_stat<HALT_TOO_SLOW> },
+	{ "too_waiting", push_halt_stat<HALT_TOO_WAITING> }
+};
+
+
+SQInteger world_get_halt_data(HSQUIRRELVM vm)
+{
+	player_t *owner = NULL;
+	if (sq_gettype(vm, 2) != OT_NULL) {
+		// null selects all owners, but an invalid player must not
+		owner = param<player_t*>::get(vm, 2);
+		if (owner == NULL) {
+			return sq_raise_error(vm, "Invalid player");
+		}
+	}
+	const vector_tpl<halthandle_t>& list = haltestelle_t::get_alle_haltestellen();
+
+	vector_tpl<halthandle_t> selected(list.get_count());
+	FOR(vector_tpl<halthandle_t>, const halt, list) {
+		if (halt.is_bound()  &&  (owner == NULL  ||  halt->get_owner() == owner)) {
+			selected.append(halt);
+		}
+	}
+	return push_bulk_fields(vm, 3, selected, halt_fields);
+}
+
+
 SQInteger halt_export_convoy_list(HSQUIRRELVM vm)
 {
 	halthandle_t halt = param<halthandle_t>::get(vm, 1);
@@ -129,6 +195,26 @@ void export_halt(HSQUIRRELVM vm)
 	 * @typemask halt_x()
 	 */
 	register_function(vm, world_get_halt_by_index, "_get",    2, "xi");
+	/**
+	 * Returns fields of all halts of a player in one call. This is much
+	 * faster than to iterate through the list and call the methods of halt_x.
+	 *
+	 * Usage:
+	 * @code
+	 * local data = halt_list_x().get_data(null, ["id", "waiting"])
+	 * // data.waiting[i] is the number of waiting passengers/goods at halt_x(data.id[i]) this month
+	 * @endcode
+	 *
+	 * Known fields: id, name, owner (player number), pos, and the values of
+	 * this month of visitors, commuters, waiting, happy, unhappy, noroute,
+	 * convoys, too_slow, too_waiting.
+	 *
+	 * @param owner only halts of this player, or null for all (an invalid player raises an error)
+	 * @param fields array with the names of the fields
+	 * @returns table with one array per field, all in the order of the list
+	 * @typemask table(player_x,array<string>)
+	 */
+	register_function(vm, world_get_halt_data,     "get_data", 3, "x t|x|y|o a");
 	end_class(vm);
 
 	/**
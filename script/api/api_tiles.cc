@@ -11,6 +11,7 @@
 #include "get_next.h"
 #include "../api_class.h"
 #include "../api_function.h"
+#include "../../dataobj/scenario.h"
 #include "../../simtool.h"
 #include "../../simworld.h"
 
@@ -96,6 +97,118 @@ vector_tpl<halthandle_t> const& square_get_halt_list(planquadrat_t *plan)
 }
 
 
+// grounds outside of the map are NULL
+static void push_tile_z(HSQUIRRELVM vm, grund_t* const& gr)
+{
+	if (gr) {
+		param<sint8>::push(vm, gr->get_hoehe());
+	}
+	else {
+		sq_pushnull(vm);
+	}
+}
+
+static void push_tile_slope(HSQUIRRELVM vm, grund_t* const& gr)
+{
+	if (gr) {
+		param<slope_t::type>::push(vm, gr->get_grund_hang());
+	}
+	else {
+		sq_pushnull(vm);
+	}
+}
+
+static void push_tile_is_water(HSQUIRRELVM vm, grund_t* const& gr)
+{
+	if (gr) {
+		param<bool>::push(vm, gr->is_water());
+	}
+	else {
+		sq_pushnull(vm);
+	}
+}
+
+static void push_tile_is_empty(HSQUIRRELVM vm, grund_t* const& gr)
+{
+	if (gr) {
+		param<bool>::push(vm, gr->ist_natur());
+	}
+	else {
+		sq_pushnull(vm);
+	}
+}
+
+static void push_tile_has_ways(HSQUIRRELVM vm, grund_t* const& gr)
+{
+	if (gr) {
+		param<bool>::push(vm, gr->hat_wege());
+	}
+	else {
+		sq_pushnull(vm);
+	}
+}
+
+static void push_tile_halt_id(HSQUIRRELVM vm, grund_t* const& gr)
+{
+	if (gr) {
+		param<uint16>::push(vm, gr->get_halt().get_id());
+	}
+	else {
+		sq_pushnull(vm);
+	}
+}
+
+static const bulk_field_t<grund_t*> tile_fields[] = {
+	{ "z",        push_tile_z },
+	{ "slope",    push_tile_slope },
+	{ "is_water", push_tile_is_water },
+	{ "is_empty", push_tile_is_empty },
+	{ "has_ways", push_tile_has_ways },
+	{ "halt_id",  push_tile_halt_id }
+};
+
+// largest rectangle for world.get_tile_data()
+#define MAX_TILE_DATA_SQUARES (512*512)
+
+SQInteger world_get_tile_data(HSQUIRRELVM vm)
+{
+	// corners in script coordinates, the rows are in this order
+	sint16 x0=-1, y0=-1, x1=-1, y1=-1;
+	get_slot(vm, "x", x0, 2);
+	get_slot(vm, "y", y0, 2);
+	get_slot(vm, "x", x1, 3);
+	get_slot(vm, "y", y1, 3);
+	if (x0 > x1) {
+		sim::swap(x0, x1);
+	}
+	if (y0 > y1) {
+		sim::swap(y0, y1);
+	}
+
+	// this is one native call, so the opcode limit of the script cannot stop it
+	koord k0(x0, y0), k1(x1, y1);
+	welt->get_scenario()->koord_sq2w(k0);
+	welt->get_scenario()->koord_sq2w(k1);
+	if (!welt->is_within_limits(k0)  ||  !welt->is_within_limits(k1)) {
+		return sq_raise_error(vm, "Rectangle (%d,%d) - (%d,%d) is not on the map", x0, y0, x1, y1);
+	}
+	const uint32 area = (uint32)(x1 - x0 + 1) * (uint32)(y1 - y0 + 1);
+	if (area > MAX_TILE_DATA_SQUARES) {
+		return sq_raise_error(vm, "Rectangle with %u squares is larger than %u squares", area, (uint32)MAX_TILE_DATA_SQUARES);
+	}
+
+	vector_tpl<grund_t*> grounds( area );
+	for(sint32 y = y0; y <= y1; y++) {
+		for(sint32 x = x0; x <= x1; x++) {
+			koord k(x, y);
+			welt->get_scenario()->koord_sq2w(k);
+			grounds.append( welt->lookup_kartenboden(k) );
+		}
+	}
+	return push_bulk_fields(vm, 4, grounds, tile_fields);
+}
+
+
 void export_tiles(HSQUIRRELVM vm)
 {
 	/**
@@ -103,6 +103,9 @@ SQInteger world_get_convoy_list(HSQUIRRELVM vm)
 }
 
 
+SQInteger world_get_tile_data(HSQUIRRELVM vm); // api_tiles.cc
+
+
 void export_world(HSQUIRRELVM vm)
 {
 	/**
@@ -308,6 +311,28 @@ void export_world(HSQUIRRELVM vm)
 	 * @typemask convoy_list_x()
 	 */
 	STATIC register_function(vm, world_get_convoy_list, "get_convoy_list", 1, ".");
+	/**
+	 * Returns fields of the ground tiles of all squares in a rectangle in one
+	 * call. This is much faster than to call square_x and tile_x methods for
+	 * every tile.
+	 *
+	 * Usage:
+	 * @code
+	 * local data = world.get_tile_data(coord(10,10), coord(19,14), ["z", "is_empty"])
+	 * // data.z[(y-10)*10 + (x-10)] is the height of the ground at (x,y)
+	 * @endcode
+	 *
+	 * Known fields: z, slope, is_water, is_empty, has_ways, halt_id (0 if none).
+	 * Both corners must be on the map, and the rectangle must not have more than
+	 * 512*512 squares, otherwise an error is raised.
+	 *
+	 * @param from one corner of the rectangle
+	 * @param to the opposite corner
+	 * @param fields array with the names of the fields
+	 * @returns table with one array per field, row by row from the smaller corner
+	 * @typemask table(coord,coord,array<string>)
+	 */
+	STATIC register_function(vm, world_get_tile_data, "get_tile_data", 4, ". t|x|y t|x|y a");
 
 	end_class(vm);
 
@@ -9,6 +9,8 @@
  *
  * @section api-trunk Current trunk
  *
+ * - Added convoy_list_x::get_data, halt_list_x::get_data, factory_list_x::get_data, world.get_tile_data
+ *
  * @section api-120-1-2 Release 120.1.2
  *
  * - Added label_x::get_text, tile_x::get_text
@@ -9,6 +9,11 @@
 
 #include "../../simtypes.h"
 #include "../../squirrel/squirrel.h"
+#include "../../squirrel/sq_extensions.h"
+#include "../../tpl/vector_tpl.h"
+#include "../../utils/for.h"
+
+#include <string.h>
 
 /**
  * Implements custom function to realize foreach-iterators.
@@ -26,4 +31,58 @@ SQInteger generic_get_next(HSQUIRRELVM vm, uint32 count);
  */
 SQInteger generic_get_next_f(HSQUIRRELVM vm, uint32 count, uint32 F(uint32) );
 
+
+/**
+ * A field of the objects in a list, which bulk queries return for the whole
+ * list in one call, instead of one call per object and field.
+ */
+template<class T> struct bulk_field_t
+{
+	const char *name;
+	/// pushes the value of the field of obj
+	void (*push)(HSQUIRRELVM vm, T const& obj);
+};
+
+/**
+ * Pushes a table with one array per requested field, which holds the values
+ * of all objects in list in the same order.
+ * @param fields_index stack index of the array with the names of the requested fields
+ * @param fields all known fields
+ */
+template<class T, uint32 N> SQInteger push_bulk_fields(HSQUIRRELVM vm, SQInteger fields_index, vector_tpl<T> const& list, const bulk_field_t<T> (&fields)[N])
+{
+	// check all names before anything is pushed
+	vector_tpl<const bulk_field_t<T>*> selected;
+	const SQInteger count = sq_getsize(vm, fields_index);
+	for(SQInteger i = 0; i < count; i++) {
+		const SQChar *name = NULL;
+		sq_pushinteger(vm, i);
+		if (SQ_SUCCEEDED(sq_get(vm, fields_index))) {
+			// the array still holds the string
+			sq_getstring(vm, -1, &name);
+			sq_pop(vm, 1);
+		}
+		uint32 f = 0;
+		while(f < N  &&  (name == NULL  ||  strcmp(name, fields[f].name) != 0)) {
+			f++;
+		}
+		if (f == N) {
+			return sq_raise_error(vm, "Unknown field %s", name ? name : "(not a string)");
+		}
+		selected.append(&fields[f]);
+	}
+
+	sq_newtable(vm);
+	FORT(vector_tpl<const bulk_field_t<T>*>, const field, selected) {
+		sq_pushstring(vm, field->name, -1);
+		sq_newarray(vm, 0);
+		FORT(const vector_tpl<T>, const& obj, list) {
+			field->push(vm, obj);
+			sq_arrayappend(vm, -2);
+		}
+		sq_newslot(vm, -3, false);
+	}
+	return 1;
+}
+
 #endif
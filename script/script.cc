@@ -13,6 +13,8 @@
 #include "../squirrel/sq_extensions.h" // for sq_call_restricted
 
 #include "../utils/log.h"
+#include "../dataobj/environment.h"
+#include "../sys/simsys.h"
 
 #include "../tpl/vector_tpl.h"
 // for error popups
@@ -33,6 +35,16 @@ static log_t* script_log = NULL;
 // list of active scripts (they share the same log-file, error and print-functions)
 static vector_tpl<script_vm_t*> all_scripts;
 
+/// reports calls which took longer than the step budget
+static void check_step_budget(uint32 start, const char* what)
+{
+	const uint32 used = dr_time() - start;
+	if (env_t::script_step_budget_ms > 0  &&  used > env_t::script_step_budget_ms) {
+		script_log->message("Script", "%s took %u ms, step budget is %u ms", what, used, env_t::script_step_budget_ms);
+	}
+}
+
+
 static void printfunc(HSQUIRRELVM, const SQChar *s, ...)
 {
 	va_list vl;
@@ -237,6 +249,12 @@ const char* script_vm_t::intern_finish_call(HSQUIRRELVM job, call_type_t ct, int
 
 		END_STACK_WATCH(job,0);
 		err = intern_call_function(job, ct, nparams, retvalue);
+
+		// a queued call may continue within the step budget,
+		// its result is passed to the callbacks then
+		if (ct == QUEUE  &&  env_t::script_step_budget_ms > 0  &&  sq_is_out_of_ops(job)) {
+			intern_resume_call(job);
+		}
 	}
 	return err;
 }
@@ -251,11 +269,13 @@ const char* script_vm_t::intern_call_function(HSQUIRRELVM job, call_type_t ct, i
 	BEGIN_STACK_WATCH(job);
 	dbg->message("script_vm_t::intern_call_function", "start: stack=%d nparams=%d ret=%d", sq_gettop(job), nparams, retvalue);
 	const char* err = NULL;
+	const uint32 start = dr_time();
 	// call the script
-	if (!SQ_SUCCEEDED(sq_call_restricted(job, nparams, retvalue, ct == FORCE))) {
+	if (!SQ_SUCCEEDED(sq_call_restricted(job, nparams, retvalue, ct == FORCE, env_t::script_ops_per_call))) {
 		err = "Call function failed";
 		retvalue = false;
 	}
+	check_step_budget(start, "Function call");
 	if (sq_getvmstate(job) != SQ_VMSTATE_SUSPENDED) {
 		// remove closure
 		sq_remove(job, retvalue ? -2 : -1);
@@ -308,9 +328,19 @@ void script_vm_t::intern_resume_call(HSQUIRRELVM job)
 	}
 
 	// resume v.m.
-	if (!SQ_SUCCEEDED(sq_resumevm(job, retvalue))) {
+	const uint32 start = dr_time();
+	bool ok = SQ_SUCCEEDED(sq_resumevm(job, retvalue, env_t::script_ops_per_call));
+	// continue while the step budget lasts, unless the script waits for something
+	while (ok  &&  env_t::script_step_budget_ms > 0  &&  sq_is_out_of_ops(job)  &&  dr_time() - start < env_t::script_step_budget_ms) {
+		if (retvalue) {
+			sq_poptop(job);
+		}
+		ok = SQ_SUCCEEDED(sq_resumevm(job, retvalue, env_t::script_ops_per_call));
+	}
+	if (!ok) {
 		retvalue = false;
 	}
+	check_step_budget(start, "Resumed call");
 	// if finished, clear stack
 	if (sq_getvmstate(job) != SQ_VMSTATE_SUSPENDED) {
 
@@ -76,9 +76,6 @@
 #ifdef MULTI_THREAD
 #include "utils/simthread.h"
 static pthread_mutex_t step_convois_mutex = PTHREAD_MUTEX_INITIALIZER;
-static vector_tpl<pthread_t> unreserve_threads;
-waytype_t convoi_t::current_waytype = road_wt;
-uint16 convoi_t::current_unreserver = 0;
 #endif
 
 //#if _MSC_VER
@@ -299,6 +296,9 @@ DBG_MESSAGE("convoi_t::~convoi_t()", "destroying %d, %p", self.get_id(), this);
 	welt->sync.remove( this );
 	welt->rem_convoi( self );
 
+	// the tiles must not keep a handle which may be reused
+	unreserve_route();
+
 	if (!welt->is_destroying())
 	{
 		clear_estimated_times();
@@ -360,60 +360,32 @@ bool convoi_t::is_waypoint( koord3d ziel ) const
 	return !haltestelle_t::get_halt(ziel,get_owner()).is_bound();
 }
 
-#ifdef MULTI_THREAD
-
-void convoi_t::unreserve_route_range(route_range_specification range)
-{
-	const vector_tpl<weg_t *> &all_ways = weg_t::get_alle_wege();
-	for (uint32 i = range.start; i <= range.end; i++)
-	{
-		weg_t* const way = all_ways[i];
-		//schiene_t* const sch = obj_cast<schiene_t>(way);
-		schiene_t* const sch = way->is_rail_type() || way->get_waytype() == air_wt ? (schiene_t*)way : NULL;
-		if (sch && sch->get_reserved_convoi().get_id() == convoi_t::current_unreserver)
-		{
-			convoihandle_t ch;
-			ch.set_id(convoi_t::current_unreserver);
-			sch->unreserve(ch);
-		}
-	}
-}
-
-#endif
-
 /**
  * unreserves the whole remaining route
  */
 void convoi_t::unreserve_route()
 {
-	// Clears all reserved tiles on the whole map belonging to this convoy.
-#ifdef MULTI_THREAD_ROUTE_UNRESERVER
-
-	current_unreserver = self.get_id();
-	current_waytype = front()->get_waytype();
+	// Each unreserve() removes the tile from reserved_tiles; the last one
+	// is found immediately, so go backwards.
+	for(  uint32 i = reserved_tiles.get_count();  i-- > 0;  ) {
+		if(  i < reserved_tiles.get_count()  ) {
+			reserved_tiles[i]->unreserve(self);
+		}
+	}
+	reserved_tiles.clear();
 
-	simthread_barrier_wait(&karte_t::unreserve_route_barrier);
-	simthread_barrier_wait(&karte_t::unreserve_route_barrier);
+	set_needs_full_route_flush(false);
+}
 
-	current_unreserver = 0;
-	current_waytype = invalid_wt;
 
-#else
-	FOR(vector_tpl<weg_t*>, const way, weg_t::get_alle_wege())
-	{
-		if(way->get_waytype() == front()->get_waytype())
-		{
-			//schiene_t* const sch = obj_cast<schiene_t>(way);
-			schiene_t* const sch = way->is_rail_type() ? (schiene_t*)way : NULL;
-			if(sch && sch->get_reserved_convoi() == self)
-			{
-				sch->unreserve(front());
-			}
+void convoi_t::remove_reserved_tile(schiene_t *sch)
+{
+	for(  uint32 i = reserved_tiles.get_count();  i-- > 0;  ) {
+		if(  reserved_tiles[i] == sch  ) {
+			reserved_tiles.remove_at( i, false );
+			return;
 		}
 	}
-#endif
-
-	set_needs_full_route_flush(false);
 }
 
 void convoi_t::reserve_own_tiles(bool unreserve)
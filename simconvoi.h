@@ -39,6 +39,7 @@
 #define MAX_MONTHS               12 // Max history
 
 class weg_t;
+class schiene_t;
 class depot_t;
 class karte_ptr_t;
 class player_t;
@@ -56,14 +57,6 @@ class departure_point_t;
 */
 typedef koordhashtable_tpl<id_pair, average_tpl<uint32>, N_BAGS_SMALL> journey_times_map;
 
-#ifdef MULTI_THREAD
-struct route_range_specification
-{
-	uint32 start;
-	uint32 end;
-};
-#endif
-
 /**
  * Base class for all vehicle consists. Convoys can be referenced by handles, see halthandle_t.
  */
@@ -789,20 +782,25 @@ public:
 	*/
 	void hat_gehalten(halthandle_t halt);
 
-#ifdef MULTI_THREAD
 private:
-	static void unreserve_route_range(route_range_specification range);
-	friend void *unreserve_route_threaded(void* args);
-	static waytype_t current_waytype;
-	static uint16 current_unreserver;
-public:
-#endif
+	/**
+	 * The tracks reserved by this convoy, in no particular order.
+	 * Kept up to date by schiene_t whenever a reservation changes.
+	 */
+	vector_tpl<schiene_t *> reserved_tiles;
 
+public:
 	/**
 	 * remove all track reservations (trains only)
 	 */
 	void unreserve_route();
 
+	/// only to be called by schiene_t
+	void add_reserved_tile(schiene_t *sch) { reserved_tiles.append(sch); }
+	void remove_reserved_tile(schiene_t *sch);
+
+	uint32 get_reserved_tile_count() const { return reserved_tiles.get_count(); }
+
 
 	route_t* get_route() { return &route; }
 	route_t* access_route() { return &route; }
@@ -2125,13 +2125,13 @@ void fabrik_t::reset_consumer_active(){
 
 void fabrik_t::step(uint32 delta_t)
 {
-	if(!has_calculated_intransit_percentages)
-	{
-		// Can only do it here (once after loading) as paths
-		// are not available when loading, even in finish_rd
-		calc_max_intransit_percentages();
-	}
+	step_production(delta_t);
+	step_distribution(delta_t);
+}
+
 
+void fabrik_t::step_production(uint32 delta_t)
+{
 	if(  delta_t==0  ) {
 		return;
 	}
@@ -2335,6 +2335,21 @@ void fabrik_t::step(uint32 delta_t)
 	if(  !desc->is_electricity_producer()  ) {
 		power = 0;
 	}
+}
+
+
+void fabrik_t::step_distribution(uint32 delta_t)
+{
+	if(!has_calculated_intransit_percentages)
+	{
+		// Can only do it here (once after loading) as paths
+		// are not available when loading, even in finish_rd
+		calc_max_intransit_percentages();
+	}
+
+	if(  delta_t==0  ) {
+		return;
+	}
 
 	delta_t_sum += delta_t;
 	if(  delta_t_sum > PRODUCTION_DELTA_T  ) {
@@ -853,6 +853,16 @@ public:
 
 	void step(uint32 delta_t);                  // factory muss auch arbeiten ("factory must also work")
 
+	/**
+	 * The two halves of step(). step_production() only changes this factory
+	 * (production, consumption, statistics), so it may run concurrently for
+	 * different factories; no simrand() in there! step_distribution() hands
+	 * the goods to halts and consumers, expands and smokes; it must be called
+	 * for all factories in fab_list order afterwards.
+	 */
+	void step_production(uint32 delta_t);
+	void step_distribution(uint32 delta_t);
+
 	void new_month();
 
 	char const* get_name() const;
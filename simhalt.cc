@@ -70,6 +70,8 @@ vector_tpl<lines_loaded_t> haltestelle_t::lines_loaded;
 
 // hash table only used during loading
 inthashtable_tpl<sint32,halthandle_t,N_BAGS_LARGE> *haltestelle_t::all_koords = NULL;
+
+halt_grid_t haltestelle_t::tile_grid;
 // since size_x*size_y < 0x1000000, we have just to shift the high bits
 #define get_halt_key(k,width) ( ((k).x*(width)+(k).y) /*+ ((k).z << 25)*/ )
 
@@ -378,10 +380,22 @@ void haltestelle_t::destroy_all()
 	}
 	delete all_koords;
 	all_koords = NULL;
+	tile_grid.clear();
 	//status_step = 0;
 }
 
 
+void haltestelle_t::rebuild_tile_grid()
+{
+	tile_grid.clear();
+	FOR(vector_tpl<halthandle_t>, const halt, alle_haltestellen) {
+		FOR(slist_tpl<tile_t>, const& i, halt->tiles) {
+			tile_grid.add( i.grund->get_pos().get_2d(), halt );
+		}
+	}
+}
+
+
 haltestelle_t::haltestelle_t(loadsave_t* file)
 {
 	// NOTE: This is not called when saving.
@@ -586,6 +600,7 @@ haltestelle_t::~haltestelle_t()
 		koord lr(0,0);
 		while(  !tiles.empty()  ) {
 			koord pos = tiles.remove_first().grund->get_pos().get_2d();
+			tile_grid.remove( pos, self );
 			planquadrat_t *pl = welt->access_nocheck(pos);
 			assert(pl);
 			for( uint8 i=0;  i<pl->get_boden_count();  i++  ) {
@@ -5314,6 +5329,7 @@ bool haltestelle_t::add_grund(grund_t *gr, bool relink_factories, bool recalc_ne
 	add_to_station_type( gr );
 	gr->set_halt( self );
 	tiles.append( gr );
+	tile_grid.add( pos, self );
 
 	// add to hashtable
 	if (all_koords) {
@@ -5477,6 +5493,7 @@ bool haltestelle_t::rem_grund(grund_t *gr)
 
 	// now remove tile from list
 	tiles.erase(i);
+	tile_grid.remove( gr->get_pos().get_2d(), self );
 #ifdef MULTI_THREAD
 	world()->await_path_explorer();
 #endif
@@ -6208,21 +6225,21 @@ void haltestelle_t::remove_halt_within_walking_distance(halthandle_t halt)
 void haltestelle_t::check_nearby_halts()
 {
 	halts_within_walking_distance.clear();
+	// Passengers walk as far as the passenger coverage,
+	// so these are the stops covering any of our tiles.
+	const uint16 cov = welt->get_settings().get_station_coverage();
+	vector_tpl<nearby_halt_t> nearby_halts;
 	FOR(slist_tpl<tile_t>, const& iter, tiles)
 	{
-		planquadrat_t *plan = welt->access(iter.grund->get_pos().get_2d());
-		if(plan)
+		nearby_halts.clear();
+		tile_grid.get_halts(iter.grund->get_pos().get_2d(), cov, nearby_halts);
+		FOR(vector_tpl<nearby_halt_t>, const& nearby, nearby_halts)
 		{
-			const nearby_halt_t *const halt_list = plan->get_haltlist();
-
-			for (int h = plan->get_haltlist_count() - 1; h >= 0; h--)
+			halthandle_t halt = nearby.halt;
+			if (halt->is_enabled(goods_manager_t::passengers))
 			{
-				halthandle_t halt = halt_list[h].halt;
-				if (halt->is_enabled(goods_manager_t::passengers))
-				{
-					add_halt_within_walking_distance(halt);
-					halt->add_halt_within_walking_distance(self);
-				}
+				add_halt_within_walking_distance(halt);
+				halt->add_halt_within_walking_distance(self);
 			}
 		}
 	}
@@ -22,6 +22,7 @@
 #include "descriptor/goods_desc.h"
 
 #include "dataobj/koord.h"
+#include "dataobj/halt_grid.h"
 
 #include "tpl/inthashtable_tpl.h"
 
@@ -130,6 +131,11 @@ private:
 	 */
 	static inthashtable_tpl<sint32,halthandle_t, N_BAGS_LARGE> *all_koords;
 
+	/**
+	 * The tiles of all stops, for coverage and walking distance queries.
+	 */
+	static halt_grid_t tile_grid;
+
 	/**
 	 * A list of lines and freight categories that have already been loaded with all available freight at the halt.
 	 * Reset each step.
@@ -273,6 +279,14 @@ public:
 	 */
 	static void destroy_all();
 
+	static const halt_grid_t& get_tile_grid() { return tile_grid; }
+
+	/**
+	 * Enters the tiles of all stops into the tile grid again,
+	 * needed after the map was rotated.
+	 */
+	static void rebuild_tile_grid();
+
 	uint32 get_number_of_halts_within_walking_distance() const;
 
 	halthandle_t get_halt_within_walking_distance(uint32 index) const { return halts_within_walking_distance[index]; }
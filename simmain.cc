@@ -6,6 +6,7 @@
 #include <stdio.h>
 #include <string>
 #include <new>
+#include <algorithm>
 
 #include "pathes.h"
 
@@ -13,6 +14,7 @@
 #include "simworld.h"
 #include "simware.h"
 #include "display/simview.h"
+#include "display/viewport.h"
 #include "gui/simwin.h"
 #include "gui/gui_theme.h"
 #include "gui/messagebox.h"
@@ -73,6 +75,7 @@
 
 #include "utils/cbuffer_t.h"
 #include "utils/simrandom.h"
+#include "utils/step_profiler.h"
 
 #include "bauer/vehikelbauer.h"
 
@@ -198,6 +201,112 @@ static void show_times(karte_t *welt, main_view_t *view)
 #endif
 
 
+/**
+ * Headless render benchmark: draws the view of the loaded game a number of times
+ * and prints the time per frame and per display thread to stdout.
+ */
+static void render_benchmark(karte_t *welt, main_view_t *view, int frames, const char *pos_str, const char *dump_filename)
+{
+#if COLOUR_DEPTH == 0
+	dbg->warning( "render_benchmark()", "Compiled without graphics (COLOUR_DEPTH=0), nothing is drawn" );
+#endif
+	intr_set_view(view);
+	intr_disable();
+
+	if(  pos_str  ) {
+		int x, y;
+		if(  sscanf(pos_str, "%i,%i", &x, &y) == 2  &&  welt->is_within_limits(x, y)  ) {
+			welt->get_viewport()->change_world_position( koord3d( x, y, welt->min_hgt( koord(x, y) ) ) );
+		}
+		else {
+			dbg->warning( "render_benchmark()", "Invalid position '%s' for -render_pos", pos_str );
+		}
+	}
+
+	// the first frame prepares the tiles and recodes all images, so it is reported separately
+	uint64 start = dr_time_us();
+	view->display(true);
+	const uint64 first_frame_us = dr_time_us() - start;
+
+	const int num_threads = max(1, (int)env_t::num_threads);
+	vector_tpl<uint32> frame_us(frames);
+	uint64 total_us = 0;
+	uint64 thread_us[MAX_THREADS];
+	for(  int t = 0;  t < MAX_THREADS;  t++  ) {
+		thread_us[t] = 0;
+	}
+
+	for(  int i = 0;  i < frames;  i++  ) {
+		start = dr_time_us();
+		view->display(true);
+		const uint32 us = (uint32)(dr_time_us() - start);
+		frame_us.append(us);
+		total_us += us;
+		for(  int t = 0;  t < num_threads;  t++  ) {
+			thread_us[t] += main_view_t::get_region_time_us(t);
+		}
+		printf( "frame %i: %u us\n", i, us );
+	}
+
+	printf( "render benchmark: %ix%i pixels, %i threads, first frame %u us\n", display_get_width(), display_get_height(), num_threads, (uint32)first_frame_us );
+	if(  frames > 0  ) {
+		std::sort( frame_us.begin(), frame_us.end() );
+		printf( "%i frames: mean %u us, min %u us, median %u us, max %u us\n", frames, (uint32)(total_us / frames), frame_us[0], frame_us[frames / 2], frame_us[frames - 1] );
+		for(  int t = 0;  t < num_threads;  t++  ) {
+			printf( "thread %i: mean %u us in display_region()\n", t, (uint32)(thread_us[t] / frames) );
+		}
+	}
+
+	if(  dump_filename  &&  !display_snapshot_to_file( scr_rect( 0, 0, display_get_width(), display_get_height() ), dump_filename )  ) {
+		dbg->warning( "render_benchmark()", "Could not write '%s'", dump_filename );
+	}
+}
+
+
+/**
+ * Headless simulation benchmark: runs a number of steps of the loaded game
+ * and prints the speed, the time per step phase and the final checklist to
+ * stdout. Two runs of the same savegame must print the same checklist.
+ */
+static void sim_benchmark(karte_t *welt, uint32 steps, const char *profile_filename)
+{
+	step_profiler_t::reset();
+	const uint32 start_steps = welt->get_steps();
+	const uint64 start = dr_time_us();
+	const checklist_t checklist = welt->run_benchmark_steps( steps );
+	const uint64 total_us = max( (uint64)1, dr_time_us() - start );
+
+	const uint32 done_steps = welt->get_steps() - start_steps;
+	const uint32 done_sync_steps = done_steps * welt->get_settings().get_frames_per_step();
+	printf( "sim benchmark: %u steps (%u sync steps) in %.3f s: %.2f steps/s, %.2f sync steps/s\n",
+		done_steps, done_sync_steps, total_us / 1000000.0, done_steps * 1000000.0 / total_us, done_sync_steps * 1000000.0 / total_us );
+
+	if(  done_steps > 0  ) {
+		printf( "%-32s %10s %6s %10s\n", "phase", "total ms", "%", "mean us" );
+		for(  int p = 0;  p < MAX_STEP_PHASES;  p++  ) {
+			const step_phase_t phase = (step_phase_t)p;
+			const uint64 phase_us = step_profiler_t::get_total( phase );
+			printf( "%*s%-*s %10.1f %6.1f %10llu\n", 2 * step_profiler_t::get_depth( phase ), "", 32 - 2 * step_profiler_t::get_depth( phase ), step_profiler_t::get_name( phase ),
+				phase_us / 1000.0, phase_us * 100.0 / total_us, (unsigned long long)(phase_us / done_steps) );
+		}
+	}
+
+	cbuffer_t buf;
+	checklist.print( buf, "checklist" );
+	printf( "%s", buf.get_str() );
+	printf( "gamestate hash: %08x\n", welt->get_gamestate_hash() );
+
+	if(  profile_filename  ) {
+		const size_t len = strlen( profile_filename );
+		const bool ok = len > 5  &&  STRICMP( profile_filename + len - 5, ".json" ) == 0 ? step_profiler_t::write_json( profile_filename ) : step_profiler_t::write_csv( profile_filename );
+		if(  !ok  ) {
+			dbg->warning( "sim_benchmark()", "Could not write '%s'", profile_filename );
+		}
+	}
+	fflush( stdout );
+}
+
+
 void modal_dialogue( gui_frame_t *gui, ptrdiff_t magic, karte_t *welt, bool (*quit)() )
 {
 	if(  display_get_width()==0  ) {
@@ -476,6 +585,15 @@ void print_help()
 		" -objects DIR_NAME/  load the pakset in specified directory\n"
 		" -pause              starts game with paused after loading\n"
 		"                     a server will pause if there are no clients, even if this be not specified in simuconf.tab\n"
+		" -profile_steps N    writes the timings of the step phases every N steps\n"
+		" -profile_file FILE  file for -profile_steps (default step_profile.csv, .json for JSON)\n"
+		" -render_bench N     renders N frames of the loaded game (-load), prints the timings and quits;\n"
+		"                     without display use the posix backend with COLOUR_DEPTH=16 and -screensize\n"
+		" -render_pos X,Y     centres the view of -render_bench on tile X,Y\n"
+		" -render_dump FILE   saves the last frame of -render_bench to FILE (.ppm, .bmp or .png)\n"
+		" -sim_bench N        runs N steps of the loaded game (-load) as fast as possible without\n"
+		"                     display and network, prints the timings and the final checklist and quits;\n"
+		"                     the step profile is written to -profile_file if given\n"
 		" -res N              starts in specified resolution: \n"
 		"                      1=640x480, 2=800x600, 3=1024x768, 4=1280x1024\n"
 		" -screensize WxH     set screensize to width W and height H\n"
@@ -1619,6 +1737,21 @@ int simu_main(int argc, char** argv)
 	}
 #endif
 
+	if(  const char *ref_str = args.gimme_arg("-profile_steps", 1)  ) {
+		const char *filename = args.gimme_arg("-profile_file", 1);
+		step_profiler_t::set_export( max(0, atoi(ref_str)), filename ? filename : "step_profile.csv" );
+	}
+
+	if(  const char *ref_str = args.gimme_arg("-render_bench", 1)  ) {
+		render_benchmark( welt, view, max(0, atoi(ref_str)), args.gimme_arg("-render_pos", 1), args.gimme_arg("-render_dump", 1) );
+		env_t::quit_simutrans = true;
+	}
+
+	if(  const char *ref_str = args.gimme_arg("-sim_bench", 1)  ) {
+		sim_benchmark( welt, max(0, atoi(ref_str)), args.gimme_arg("-profile_file", 1) );
+		env_t::quit_simutrans = true;
+	}
+
 	welt->reset_timer();
 	if(  !env_t::networkmode  &&  !env_t::server  &&  new_world  ) {
 #ifdef display_in_main
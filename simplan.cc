@@ -204,6 +204,7 @@ void planquadrat_t::kartenboden_setzen(grund_t *bd, bool startup)
 		bd->calc_image();
 	}
 	minimap_t::get_instance()->calc_map_pixel(bd->get_pos().get_2d());
+	welt->update_free_area( bd->get_pos().get_2d() );
 }
 
 
@@ -241,6 +242,7 @@ void planquadrat_t::boden_ersetzen(grund_t *alt, grund_t *neu)
 		}
 		delete alt;
 	}
+	welt->update_free_area( neu->get_pos().get_2d() );
 }
 
 
@@ -802,9 +804,15 @@ void planquadrat_t::add_to_haltlist(halthandle_t halt)
 	{
 		// Quick and dirty way to our 2d co-ordinates
 		const koord pos = get_kartenboden()->get_pos().get_2d();
-		const koord halt_next_pos = halt->get_next_pos(pos, true);
 		// Must be koord_distance not shortest_distance as the coverage radii are square, not circular
-		const uint8 distance = (uint8)koord_distance(halt_next_pos, pos);
+		const uint16 cov = max(welt->get_settings().get_station_coverage(), welt->get_settings().get_station_coverage_factories());
+		uint16 grid_distance;
+		if(!haltestelle_t::get_tile_grid().get_distance(pos, halt, cov, grid_distance))
+		{
+			// outside of any coverage: search all tiles of the halt
+			grid_distance = koord_distance(halt->get_next_pos(pos, true), pos);
+		}
+		const uint8 distance = (uint8)grid_distance;
 		if(halt_list_count > 0)
 		{
 			// Since only the first one gets all, we want the closest halt one to be first
@@ -848,20 +856,12 @@ void planquadrat_t::remove_from_haltlist(halthandle_t halt)
 	else if (halt->get_ware_enabled()) {
 		new_cov = welt->get_settings().get_station_coverage_factories();
 	}
-	for (int y = -cov; y <= cov; y++) {
-		for (int x = -cov; x <= cov; x++) {
-			koord test_pos = pos+koord(x,y);
-			const planquadrat_t *pl = welt->access(test_pos);
-			if (pl) {
-				for(  uint i = 0;  i < pl->get_boden_count();  i++  ) {
-					if (  pl->get_boden_bei(i)->get_halt() == halt && (abs(x)<=new_cov &&  abs(y)<=new_cov)) {
-						// still connected
-						// Reset distance computation
-						add_to_haltlist(halt);
-					}
-				}
-			}
-		}
+	const uint16 radius = min(cov, new_cov);
+	uint16 distance;
+	if(  haltestelle_t::get_tile_grid().get_distance(pos, halt, radius, distance)  ) {
+		// still connected
+		// Reset distance computation
+		add_to_haltlist(halt);
 	}
 }
 
@@ -34,25 +34,32 @@ class planquadrat_t
 {
 	static karte_ptr_t welt;
 private:
+	/*
+	 * The pointers come first and the byte sized fields last, so that the
+	 * tile packs into 32 bytes on 64 bit systems instead of 40 with padding
+	 * between each pointer and byte. There is one of these per map tile, so
+	 * this matters for the memory and cache footprint of large maps.
+	 */
+
 	/* list of stations that are reaching to this tile (saves lots of time for lookup) */
 	nearby_halt_t *halt_list;
 
-	uint8 ground_size, halt_list_count;
-
 	/**
 	 * If this tile belongs to a city, a pointer to that city.
 	 * This saves much lookup time
 	 */
 	stadt_t* city;
 
-	// stores climate related settings
-	uint8 climate_data;
-
 	union DATA {
 		grund_t ** some;    // valid if capacity > 1
 		grund_t * one;      // valid if capacity == 1
 	} data;
 
+	uint8 ground_size, halt_list_count;
+
+	// stores climate related settings
+	uint8 climate_data;
+
 public:
 	/**
 	 * Constructs a planquadrat (tile) with initial capacity of one ground
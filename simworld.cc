@@ -93,6 +93,8 @@
 #include "utils/cbuffer_t.h"
 #include "utils/simrandom.h"
 #include "utils/simstring.h"
+#include "utils/step_profiler.h"
+#include "utils/task_pool.h"
 
 #include "network/memory_rw.h"
 
@@ -128,7 +130,6 @@
 #include "utils/simthread.h"
 
 static vector_tpl<pthread_t> private_car_route_threads;
-static vector_tpl<pthread_t> unreserve_route_threads;
 static vector_tpl<pthread_t> step_passengers_and_mail_threads;
 static vector_tpl<pthread_t> individual_convoy_step_threads;
 static vector_tpl<pthread_t> path_explorer_threads;
@@ -141,16 +142,13 @@ static pthread_mutexattr_t mutex_attributes;
 //static pthread_mutex_t private_car_route_mutex = PTHREAD_MUTEX_INITIALIZER;
 //pthread_mutex_t karte_t::step_passengers_and_mail_mutex = PTHREAD_MUTEX_INITIALIZER;
 //static pthread_mutex_t path_explorer_await_mutex = PTHREAD_MUTEX_INITIALIZER;
-//pthread_mutex_t karte_t::unreserve_route_mutex = PTHREAD_MUTEX_INITIALIZER;
 
 pthread_mutex_t karte_t::private_car_route_mutex;
 bool karte_t::private_car_route_mutex_initialised;
 pthread_mutex_t karte_t::step_passengers_and_mail_mutex;
 static pthread_mutex_t path_explorer_await_mutex;
-pthread_mutex_t karte_t::unreserve_route_mutex;
 
 simthread_barrier_t karte_t::private_car_barrier;
-simthread_barrier_t karte_t::unreserve_route_barrier;
 static simthread_barrier_t step_passengers_and_mail_barrier;
 static simthread_barrier_t path_explorer_barrier;
 static simthread_barrier_t step_convoys_barrier_internal;
@@ -484,6 +482,7 @@ void karte_t::destroy()
 	is_sound = false; // karte_t::play_sound_area_clipped needs valid zeiger (pointer/drawer)
 	destroying = true;
 	DBG_MESSAGE("karte_t::destroy()", "destroying world");
+	free_area_index.clear();
 
 #ifdef MULTI_THREAD
 	suspend_private_car_threads();
@@ -767,6 +766,33 @@ void karte_t::set_scenario(scenario_t *s)
 }
 
 
+/// the search for one river, from one source to the candidate mouths
+struct river_search_t
+{
+	karte_t *welt;
+	koord start;
+	const koord *ends;
+	way_builder_t **builders;
+	uint32 seed;
+	/// number of the candidate in ends[0]
+	uint32 first;
+};
+
+
+static void calc_river_task(void *ptr, uint32 task)
+{
+	const river_search_t *search = static_cast<const river_search_t *>(ptr);
+	const koord end = search->ends[task];
+	way_builder_t &riverbuilder = *search->builders[task];
+	// the noise of the river costs only depends on the candidate
+	simrand_stream_t stream( search->seed, search->first + task + 1 );
+	riverbuilder.set_random_stream( &stream );
+	riverbuilder.set_maximum( koord_distance(search->start, end) * 50 );
+	riverbuilder.calc_route( search->welt->lookup_kartenboden(end)->get_pos(), search->welt->lookup_kartenboden(search->start)->get_pos() );
+	riverbuilder.set_random_stream( NULL );
+}
+
+
 void karte_t::create_rivers( sint16 number )
 {
 	// First check, whether there is a canal:
@@ -803,6 +829,16 @@ void karte_t::create_rivers( sint16 number )
 		return;
 	}
 
+	// The candidate mouths of a river are searched in parallel, a batch at a time;
+	// the first candidate which gives a long enough river is built. Each candidate
+	// has its own random numbers, so the rivers do not depend on the number of threads.
+	task_pool_t pool( env_t::num_threads );
+	const uint32 batch_size = pool.get_thread_count();
+	way_builder_t *builders[MAX_THREADS];
+	for(  uint32 i = 0;  i < batch_size;  i++  ) {
+		builders[i] = new way_builder_t(players[1]);
+	}
+
 	// now make rivers
 	int river_count = 0;
 	sint16 retrys = number*2;
@@ -823,26 +859,50 @@ void karte_t::create_rivers( sint16 number )
 		}
 
 		// now try 512 random locations
-		for(  sint32 i=0;  i<512  &&  !valid_water_tiles.empty();  i++  ) {
-			koord const end = pick_any(valid_water_tiles);
-			valid_water_tiles.remove( end );
-			way_builder_t riverbuilder(players[1]);
-			riverbuilder.init_builder(way_builder_t::river, river_desc);
-			sint16 dist = koord_distance(start,end);
-			riverbuilder.set_maximum( dist*50 );
-			riverbuilder.calc_route( lookup_kartenboden(end)->get_pos(), lookup_kartenboden(start)->get_pos() );
-			if(  riverbuilder.get_count() >= (uint32)settings.get_min_river_length()  ) {
-				// do not built too short rivers
-				riverbuilder.build();
-				river_count++;
-				number--;
-				retrys++;
-				break;
+		const uint32 seed = simrand_plain();
+		simrand_stream_t order( seed, 0 );
+		vector_tpl<koord> ends;
+		while(  ends.get_count() < 512  &&  !valid_water_tiles.empty()  ) {
+			const uint32 i = order.rand( valid_water_tiles.get_count() );
+			ends.append( valid_water_tiles[i] );
+			valid_water_tiles.remove_at( i );
+		}
+
+		river_search_t search;
+		search.welt = this;
+		search.start = start;
+		search.seed = seed;
+		search.builders = builders;
+		bool built = false;
+		for(  uint32 first = 0;  first < ends.get_count()  &&  !built;  first += batch_size  ) {
+			const uint32 count = min( batch_size, ends.get_count() - first );
+			search.ends = ends.begin() + first;
+			search.first = first;
+			for(  uint32 i = 0;  i < count;  i++  ) {
+				builders[i]->init_builder( way_builder_t::river, river_desc );
+			}
+			pool.run( calc_river_task, &search, count );
+
+			for(  uint32 i = 0;  i < count;  i++  ) {
+				if(  builders[i]->get_count() >= (uint32)settings.get_min_river_length()  ) {
+					// do not built too short rivers
+					builders[i]->build();
+					river_count++;
+					number--;
+					retrys++;
+					built = true;
+					break;
+				}
 			}
 		}
 
 		retrys--;
 	}
+
+	for(  uint32 i = 0;  i < batch_size;  i++  ) {
+		delete builders[i];
+	}
+
 	// we gave up => tell the user
 	if(  number>0  ) {
 		dbg->warning( "karte_t::create_rivers()","Too many rivers requested! (only %i rivers placed)", river_count );
@@ -875,6 +935,59 @@ void karte_t::add_queued_city(stadt_t* city)
 #endif
 }
 
+/// an intercity road, planned in advance in the second phase of distribute_cities()
+struct intercity_connection_t
+{
+	koord conn;
+	sint32 dist;
+	koord3d start, end;
+	vehicle_t *test_driver;
+	way_builder_t *builder;
+	// results
+	bool connected;
+	uint32 route_count;
+	bool build;
+};
+
+
+static void calc_intercity_connection_task(void *ptr, uint32 task)
+{
+	intercity_connection_t &c = static_cast<intercity_connection_t *>(ptr)[task];
+	// the same decisions as in distribute_cities()
+	route_t verbindung;
+	c.connected = verbindung.calc_route( world(), c.start, c.end, c.test_driver, 0, 0, false, 0 ) != route_t::no_route;
+	c.route_count = verbindung.get_count();
+	c.build = false;
+	if(  c.connected  ) {
+		if(  2 * c.route_count > (uint32)c.dist  ) {
+			c.builder->set_maximum( c.route_count / 2 );
+			c.build = true;
+		}
+	}
+	else {
+		c.builder->set_maximum( env_t::intercity_road_length );
+		c.build = true;
+	}
+	if(  c.build  ) {
+		c.builder->calc_route( c.start, c.end );
+	}
+}
+
+
+struct intercity_candidate_t
+{
+	sint32 dist;
+	sint32 i, j;
+};
+
+
+static bool compare_intercity_candidates(const intercity_candidate_t &a, const intercity_candidate_t &b)
+{
+	// the order in which the search in distribute_cities() finds them
+	return a.dist < b.dist  ||  (a.dist == b.dist  &&  (a.i < b.i  ||  (a.i == b.i  &&  a.j < b.j)));
+}
+
+
 void karte_t::distribute_cities(settings_t const * const sets, sint16 old_x, sint16 old_y)
 {
 	sint32 new_city_count = abs(sets->get_city_count());
@@ -1134,11 +1247,28 @@ void karte_t::distribute_cities(settings_t const * const sets, sint16 old_x, sin
 		}
 
 		// get a default vehicle
-		route_t verbindung;
-		vehicle_t* test_driver;
 		vehicle_desc_t test_drive_desc(road_wt, 500, vehicle_desc_t::diesel);
-		test_driver = vehicle_builder_t::build(koord3d(), players[1], NULL, &test_drive_desc);
-		test_driver->set_flag(obj_t::not_on_map);
+
+		// The second phase mostly finds cities which are connected well enough
+		// already, which does not change the map. Thus the next connections are
+		// searched in parallel, assuming that none of them will be built. The
+		// results are used in the same order as before, and are discarded when
+		// a road is built; so the roads are the same as with a serial search.
+		task_pool_t pool( env_t::num_threads );
+		const uint32 plan_size = pool.get_thread_count() > 1 ? 4 * pool.get_thread_count() : 1;
+		vector_tpl<intercity_connection_t> planned( plan_size );
+		uint32 planned_next = 0;
+		for(  uint32 p = 0;  p < plan_size;  p++  ) {
+			intercity_connection_t c;
+			c.test_driver = vehicle_builder_t::build(koord3d(), players[1], NULL, &test_drive_desc);
+			c.test_driver->set_flag(obj_t::not_on_map);
+			c.builder = new way_builder_t(NULL);
+			c.builder->init_builder(way_builder_t::strasse | way_builder_t::terraform_flag, desc, tunnel_builder_t::get_tunnel_desc(road_wt, desc->get_topspeed(), get_timeline_year_month()), bridge_builder_t::find_bridge(road_wt, desc->get_topspeed(), get_timeline_year_month(), desc->get_max_axle_load() * 2));
+			c.builder->set_keep_existing_ways(true);
+			planned.append( c );
+		}
+		uint32 planned_count = 0;
+		vector_tpl<intercity_candidate_t> candidates;
 
 		bool ready = false;
 		uint8 phase = 0;
@@ -1215,28 +1345,57 @@ void karte_t::distribute_cities(settings_t const * const sets, sint16 old_x, sin
 			}
 			// valid connection?
 			if (conn.x >= 0) {
-				// is there a connection already
-				const bool connected = (phase == 1 && verbindung.calc_route(this, k[conn.x], k[conn.y], test_driver, 0, 0, false, 0)) == route_t::valid_route;
-				// build this connection?
+				way_builder_t *builder = &bauigel;
 				bool build = false;
-				// set appropriate max length for way builder
-				if (connected) {
-					if (2 * verbindung.get_count() > (uint32)city_dist.at(conn)) {
-						bauigel.set_maximum(verbindung.get_count() / 2);
-						build = true;
+				if (phase == 1) {
+					// skip the planned connections which the search has passed over
+					while (planned_next < planned_count  &&  planned[planned_next].conn != conn) {
+						planned_next++;
 					}
+					if (planned_next == planned_count) {
+						// plan conn and the next candidates in the order of the search
+						candidates.clear();
+						for (int i = 0; plan_size > 1  &&  i < settings.get_city_count(); ++i) {
+							for (int j = max(old_city_count, i + 1); j < settings.get_city_count(); ++j) {
+								if (city_dist.at(i, j) < env_t::intercity_road_length  &&  city_flag[i] == city_flag[j]  &&  koord(i, j) != conn) {
+									intercity_candidate_t c;
+									c.dist = city_dist.at(i, j);
+									c.i = i;
+									c.j = j;
+									if (!compare_intercity_candidates(c, intercity_candidate_t{ city_dist.at(conn), conn.x, conn.y })) {
+										candidates.append(c);
+									}
+								}
+							}
+						}
+						const uint32 n = min(plan_size - 1, candidates.get_count());
+						std::partial_sort(candidates.begin(), candidates.begin() + n, candidates.end(), compare_intercity_candidates);
+						planned_count = n + 1;
+						for (uint32 p = 0; p < planned_count; p++) {
+							intercity_connection_t &c = planned[p];
+							c.conn = p == 0 ? conn : koord(candidates[p - 1].i, candidates[p - 1].j);
+							c.dist = city_dist.at(c.conn);
+							c.start = k[c.conn.x];
+							c.end = k[c.conn.y];
+						}
+						pool.run(calc_intercity_connection_task, planned.begin(), planned_count);
+						planned_next = 0;
+					}
+					const intercity_connection_t &c = planned[planned_next++];
+					builder = c.builder;
+					build = c.build;
 				}
 				else {
+					// in the first phase, cities are never connected yet
 					bauigel.set_maximum(env_t::intercity_road_length);
 					build = true;
-				}
-
-				if (build) {
 					bauigel.calc_route(k[conn.x], k[conn.y]);
 				}
 
-				if (build  &&  bauigel.get_count() >= 2) {
-					bauigel.build();
+				if (build  &&  builder->get_count() >= 2) {
+					builder->build();
+					// the map has changed
+					planned_count = 0;
 					if (phase == 0) {
 						city_flag[conn.y] = conn_comp;
 					}
@@ -1273,7 +1432,10 @@ void karte_t::distribute_cities(settings_t const * const sets, sint16 old_x, sin
 				ready = false;
 			}
 		}
-		delete test_driver;
+		FOR(vector_tpl<intercity_connection_t>, const& c, planned) {
+			delete c.test_driver;
+			delete c.builder;
+		}
 	}
 }
 
@@ -1453,6 +1615,12 @@ DBG_DEBUG("karte_t::init()","built timeline");
 	dbg->message("karte_t::init()", "Creating factories ...");
 	factory_builder_t::new_world();
 
+	// the sites for the factories and attractions are searched in parallel
+	task_pool_t site_search_pool( env_t::num_threads );
+	factory_builder_t::set_site_search_pool( &site_search_pool );
+	// the tasks use the hints of square_is_free(), but cannot build them
+	free_area_index.init( this );
+
 	int consecutive_build_failures = 0;
 
 	loadingscreen_t ls( translator::translate("distributing factories"), 16 + settings.get_city_count() * 4 + settings.get_factory_count(), true, true );
@@ -1477,6 +1645,7 @@ DBG_DEBUG("karte_t::init()","built timeline");
 	ls.set_what(translator::translate("Placing attractions ..."));
 	// Not worth actually constructing a progress bar, very fast
 	factory_builder_t::distribute_attractions(settings.get_tourist_attractions());
+	factory_builder_t::set_site_search_pool( NULL );
 
 	ls.set_what(translator::translate("Finalising ..."));
 	// Not worth actually constructing a progress bar, very fast
@@ -2005,54 +2174,6 @@ void karte_t::start_path_explorer()
 	path_explorer_working = true;
 #endif
 }
-
-void* unreserve_route_threaded(void* args)
-{
-	const uint32* thread_number_ptr = (const uint32*)args;
-	const uint32 thread_number = *thread_number_ptr;
-	delete thread_number_ptr;
-
-	do
-	{
-		simthread_barrier_wait(&karte_t::unreserve_route_barrier);
-
-		if (karte_t::world->is_terminating_threads())
-		{
-			break;
-		}
-		if (convoi_t::current_unreserver == 0)
-		{
-			int error = pthread_mutex_unlock(&karte_t::unreserve_route_mutex);
-			assert(error == 0);
-			(void)error;
-
-			continue;
-		}
-
-		const uint32 max_count = weg_t::get_all_ways_count() - 1;
-		const uint32 fraction = max_count / karte_t::world->get_parallel_operations();
-
-		route_range_specification range;
-
-		range.start = thread_number * fraction;
-		if (thread_number == karte_t::world->get_parallel_operations() - 1)
-		{
-			range.end = max_count;
-		}
-		else
-		{
-			range.end = min(((thread_number + 1) * fraction - 1), max_count);
-		}
-
-		convoi_t::unreserve_route_range(range);
-
-		simthread_barrier_wait(&karte_t::unreserve_route_barrier);
-
-	} while (!karte_t::world->is_terminating_threads());
-
-	pthread_exit(NULL);
-	return args;
-}
 #endif
 
 void karte_t::await_all_threads()
@@ -2090,8 +2211,7 @@ void karte_t::init_threads()
 	const bool one_private_car_thread = false; // Because we allow servers to run private car threading in the background when no clients are connected, we should now always allow multiple thread instances here.
 
 	simthread_barrier_init(&private_car_barrier, NULL, one_private_car_thread ? 2 : parallel_operations + 1);
-	simthread_barrier_init(&karte_t::unreserve_route_barrier, NULL, parallel_operations + 2); // This and the next does not run concurrently with anything significant on the main thread, so the number of parallel operations need to be +1 compared to the others.
-	simthread_barrier_init(&step_passengers_and_mail_barrier, NULL, parallel_operations + 2);
+	simthread_barrier_init(&step_passengers_and_mail_barrier, NULL, parallel_operations + 2); // This does not run concurrently with anything significant on the main thread, so the number of parallel operations need to be +1 compared to the others.
 	simthread_barrier_init(&step_convoys_barrier_external, NULL, 2);
 	simthread_barrier_init(&step_convoys_barrier_internal, NULL, parallel_operations + 1);
 	simthread_barrier_init(&path_explorer_barrier, NULL, 2);
@@ -2105,7 +2225,6 @@ void karte_t::init_threads()
 
 	pthread_mutex_init(&step_passengers_and_mail_mutex, &mutex_attributes);
 	pthread_mutex_init(&path_explorer_await_mutex, &mutex_attributes);
-	pthread_mutex_init(&unreserve_route_mutex, &mutex_attributes);
 
 	pthread_t thread;
 
@@ -2126,18 +2245,6 @@ void karte_t::init_threads()
 			}
 			private_car_threads_working = false;
 		}
-		// The next two need an extra thread compared with the others, as they do not run concurrently with anything non-trivial on the main thread
-		sint32* thread_number_unres = new sint32;
-		*thread_number_unres = i;
-		rc = pthread_create(&thread, &thread_attributes, &unreserve_route_threaded, (void*)thread_number_unres);
-		if (rc)
-		{
-			dbg->fatal("void karte_t::init_threads()", "Failed to create private car thread, error %d. See here for a translation of the error numbers: http://epydoc.sourceforge.net/stdlib/errno-module.html", rc);
-		}
-		else
-		{
-			unreserve_route_threads.append(thread);
-		}
 
 #ifdef MULTI_THREAD_PASSENGER_GENERATION
 		sint32* thread_number_pass = new sint32;
@@ -2224,7 +2331,6 @@ void karte_t::destroy_threads()
 		await_private_car_threads();
 		simthread_barrier_wait(&private_car_barrier);
 
-		simthread_barrier_wait(&unreserve_route_barrier);
 #ifdef MULTI_THREAD_PATH_EXPLORER
 		simthread_barrier_wait(&path_explorer_barrier);
 		pthread_join(path_explorer_thread, 0);
@@ -2241,8 +2347,6 @@ void karte_t::destroy_threads()
 		step_passengers_and_mail_threads.clear();
 #endif
 
-		clean_threads(&unreserve_route_threads);
-		unreserve_route_threads.clear();
 #ifdef MULTI_THREAD_CONVOYS
 		simthread_barrier_destroy(&step_convoys_barrier_external);
 		simthread_barrier_destroy(&step_convoys_barrier_internal);
@@ -2251,7 +2355,6 @@ void karte_t::destroy_threads()
 		simthread_barrier_destroy(&step_passengers_and_mail_barrier);
 #endif
 		simthread_barrier_destroy(&private_car_barrier);
-		simthread_barrier_destroy(&unreserve_route_barrier);
 
 #ifdef MULTI_THREAD_PATH_EXPLORER
 		simthread_barrier_destroy(&path_explorer_barrier);
@@ -2262,7 +2365,6 @@ void karte_t::destroy_threads()
 		private_car_route_mutex_initialised = false;
 		pthread_mutex_destroy(&step_passengers_and_mail_mutex);
 		pthread_mutex_destroy(&path_explorer_await_mutex);
-		pthread_mutex_destroy(&unreserve_route_mutex);
 
 		pthread_mutexattr_destroy(&mutex_attributes);
 	}
@@ -4483,6 +4585,9 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 	delete [] grid_hgts;
 	grid_hgts = new_hgts;
 
+	// the hints of square_is_free() are rebuilt on demand
+	free_area_index.clear();
+
 	// rotate borders
 	sint16 xw = cached_size.x;
 	cached_size.x = cached_size.y;
@@ -4500,6 +4605,7 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 	FOR(vector_tpl<halthandle_t>, const s, haltestelle_t::get_alle_haltestellen()) {
 		s->rotate90(cached_size.x);
 	}
+	haltestelle_t::rebuild_tile_grid();
 
 #ifdef MULTI_THREAD
 	const sint32 po = get_parallel_operations() + 2;
@@ -4584,6 +4690,10 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 		// the map must be reinit
 		minimap_t::get_instance()->init();
 	}
+	else {
+		// same size, but the cached colours are for the old orientation
+		minimap_t::get_instance()->rotate90();
+	}
 
 	//  rotate map search array
 	factory_builder_t::new_world();
@@ -4868,6 +4978,7 @@ void karte_t::sync_step(uint32 delta_t, bool do_sync_step, bool display )
 	set_random_mode( SYNC_STEP_RANDOM );
 	if(do_sync_step) {
 		// Only omitted when called to display a new frame during fast forward
+		STEP_PROFILE(PHASE_SYNC_STEP);
 
 		// just for progress
 		if(  delta_t > 10000  ) {
@@ -5122,9 +5233,7 @@ void karte_t::new_month()
 
 	// this should be done before a map update, since the map may want an update of the way usage
 //	DBG_MESSAGE("karte_t::new_month()","ways");
-	FOR(vector_tpl<weg_t*>, const w, weg_t::get_alle_wege()) {
-		w->new_month();
-	}
+	weg_t::new_month_all();
 
 	// Update the maximum vehicle speed records to calibrate when passengers should not burden the journey time database.
 	calc_max_vehicle_speeds();
@@ -5583,6 +5692,8 @@ void karte_t::step()
 	rands[8] = get_random_seed();
 	DBG_DEBUG4("karte_t::step", "start step");
 	uint32 time = dr_time();
+	const uint64 step_start_us = dr_time_us();
+	uint64 phase_start_us;
 
 	// calculate delta_t before handling overflow in ticks
 	const sint32 delta_t = (sint32)(ticks-last_step_ticks);
@@ -5604,6 +5715,7 @@ void karte_t::step()
 		next_month_ticks += karte_t::ticks_per_world_month;
 
 		DBG_DEBUG4("karte_t::step", "calling new_month");
+		STEP_PROFILE(PHASE_NEW_MONTH);
 		new_month();
 	}
 	rands[9] = get_random_seed();
@@ -5672,6 +5784,7 @@ void karte_t::step()
 	const bool check_city_routes = true;
 	if (check_city_routes)
 	{
+		STEP_PROFILE(PHASE_PRIVATE_CAR_ROUTES);
 		const sint32 parallel_operations = get_parallel_operations();
 
 		if (cities_awaiting_private_car_route_check.empty() && cities_to_process <= 0)
@@ -5714,6 +5827,7 @@ void karte_t::step()
 	const bool snowline_change = pending_snowline_change > 0;
 	if(  season_change  ||  snowline_change  ) {
 		DBG_DEBUG4("karte_t::step", "pending_season_change");
+		STEP_PROFILE(PHASE_SEASONS);
 		// process
 		const uint32 end_count = min( cached_grid_size.x * cached_grid_size.y,  tile_counter + max( 16384, cached_grid_size.x * cached_grid_size.y / 16 ) );
 		while(  tile_counter < end_count  ) {
@@ -5740,6 +5854,7 @@ void karte_t::step()
 	// to make sure the tick counter will be updated
 	INT_CHECK("karte_t::step 1");
 
+	phase_start_us = dr_time_us();
 #ifdef MULTI_THREAD_PATH_EXPLORER
 	// Stop the path explorer before we use its results.
 	await_path_explorer();
@@ -5747,10 +5862,12 @@ void karte_t::step()
 	// Knightly : calling global path explorer
 	path_explorer_t::step();
 #endif
+	step_profiler_t::add_time(PHASE_PATH_EXPLORER, dr_time_us() - phase_start_us);
 	rands[12] = get_random_seed();
 
 	INT_CHECK("karte_t::step 2");
 
+	phase_start_us = dr_time_us();
 #ifdef MULTI_THREAD_CONVOYS
 	// Finish the threaded part of the convoys' steps: this is mainly route searches. Block reservation, etc., is in the single threaded part.
 	await_convoy_threads();
@@ -5761,12 +5878,14 @@ void karte_t::step()
 		cnv->threaded_step();
 	}
 #endif
+	step_profiler_t::add_time(PHASE_CONVOYS_THREADED, dr_time_us() - phase_start_us);
 
 	rands[13] = get_random_seed();
 
 	// The more computationally intensive parts of this have been extracted and made multi-threaded.
 	DBG_DEBUG4("karte_t::step 4", "step %d convois", convoi_array.get_count());
 	// since convois will be deleted during stepping, we need to step backwards
+	phase_start_us = dr_time_us();
 	for (uint32 i = convoi_array.get_count(); i-- != 0;) {
 		convoihandle_t cnv = convoi_array[i];
 		cnv->step();
@@ -5774,6 +5893,7 @@ void karte_t::step()
 			INT_CHECK("karte_t::step 3");
 		}
 	}
+	step_profiler_t::add_time(PHASE_CONVOYS, dr_time_us() - phase_start_us);
 
 	rands[14] = get_random_seed();
 
@@ -5791,10 +5911,12 @@ void karte_t::step()
 #ifndef CONCURRENT_ROUTE_PROCESSING
 	uint32 step_cities_count = 0;
 #endif
+	phase_start_us = dr_time_us();
 	FOR(weighted_vector_tpl<stadt_t*>, const i, stadt)
 	{
 		i->step(delta_t);
 	}
+	step_profiler_t::add_time(PHASE_CITIES, dr_time_us() - phase_start_us);
 
 	rands[15] = get_random_seed();
 
@@ -5804,11 +5926,14 @@ void karte_t::step()
 	// The placement of this method call must be before any code that in any way relies on the private car routes between cities, most especially the mail and passenger generation (step_passengers_and_mail(delta_t)).
 	if (check_city_routes)
 	{
+		STEP_PROFILE(PHASE_AWAIT_PRIVATE_CARS);
 		await_private_car_threads();
 	}
 #endif
 
+	phase_start_us = dr_time_us();
 	weg_t::apply_travel_time_updates();
+	step_profiler_t::add_time(PHASE_TRAVEL_TIMES, dr_time_us() - phase_start_us);
 
 	rands[16] = get_random_seed();
 
@@ -5825,6 +5950,7 @@ void karte_t::step()
 	rands[31] = 0;
 	rands[23] = 0;
 
+	phase_start_us = dr_time_us();
 	sint32 po;
 #ifdef MULTI_THREAD
 	po = get_parallel_operations() + 2;
@@ -5897,11 +6023,14 @@ void karte_t::step()
 	}
 
 	rands[18] = get_random_seed();
+	step_profiler_t::add_time(PHASE_PASSENGERS_MAIL, dr_time_us() - phase_start_us);
 
 	INT_CHECK("karte_t::step 4");
 
 	// This does nothing if the threading is disabled.
+	phase_start_us = dr_time_us();
 	await_passengers_and_mail_threads();
+	step_profiler_t::add_time(PHASE_AWAIT_PASSENGERS_MAIL, dr_time_us() - phase_start_us);
 
 	rands[19] = get_random_seed();
 
@@ -5972,9 +6101,19 @@ void karte_t::step()
 	INT_CHECK("karte_t::step 5");
 
 	DBG_DEBUG4("karte_t::step", "step factories");
+	// production only touches the factory itself and is done in parallel;
+	// deliveries to halts and consumers follow in the usual order
+	phase_start_us = dr_time_us();
+	factories_delta_t = delta_t;
+	world_xy_loop(&karte_t::step_factories_production, 0);
+	const uint64 distribution_start_us = dr_time_us();
 	FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
-		f->step(delta_t);
+		f->step_distribution(delta_t);
 	}
+	const uint64 factories_end_us = dr_time_us();
+	step_profiler_t::add_time(PHASE_FACTORY_PRODUCTION, distribution_start_us - phase_start_us);
+	step_profiler_t::add_time(PHASE_FACTORY_DISTRIBUTION, factories_end_us - distribution_start_us);
+	step_profiler_t::add_time(PHASE_FACTORIES, factories_end_us - phase_start_us);
 	rands[20] = get_random_seed();
 
 	finance_history_year[0][WORLD_FACTORIES] = finance_history_month[0][WORLD_FACTORIES] = fab_list.get_count();
@@ -5982,9 +6121,11 @@ void karte_t::step()
 	// step powerlines - required order: pumpe, senke, then powernet
 	// This is not computationally intensive.
 	DBG_DEBUG4("karte_t::step", "step poweline stuff");
+	phase_start_us = dr_time_us();
 	pumpe_t::step_all( delta_t );
 	senke_t::step_all( delta_t );
 	powernet_t::step_all( delta_t );
+	step_profiler_t::add_time(PHASE_POWERNET, dr_time_us() - phase_start_us);
 	rands[21] = get_random_seed();
 
 	INT_CHECK("karte_t::step 6");
@@ -5992,17 +6133,20 @@ void karte_t::step()
 	DBG_DEBUG4("karte_t::step", "step players");
 	// then step all players
 	// This is not computationally intensive (except possibly occasionally when liquidating a company)
+	phase_start_us = dr_time_us();
 	for(  int i=0;  i<MAX_PLAYER_COUNT;  i++  ) {
 		if(  players[i] != NULL  ) {
 			players[i]->step();
 		}
 	}
+	step_profiler_t::add_time(PHASE_PLAYERS, dr_time_us() - phase_start_us);
 	rands[22] = get_random_seed();
 
 	INT_CHECK("karte_t::step 7");
 
 	// This is not computationally intensive
 	DBG_DEBUG4("karte_t::step", "step halts");
+	phase_start_us = dr_time_us();
 	haltestelle_t::step_all();
 	rands[23] = get_random_seed();
 
@@ -6017,15 +6161,19 @@ void karte_t::step()
 	{
 		path_explorer_t::refresh_all_categories(false);
 	}
+	step_profiler_t::add_time(PHASE_HALTS, dr_time_us() - phase_start_us);
 
 	rands[24] = get_random_seed();
 
 	INT_CHECK("karte_t::step 8");
 
+	phase_start_us = dr_time_us();
 	check_transferring_cargoes();
+	step_profiler_t::add_time(PHASE_TRANSFERS, dr_time_us() - phase_start_us);
 
 	rands[25] = get_random_seed();
 
+	phase_start_us = dr_time_us();
 #ifdef MULTI_THREAD_PATH_EXPLORER
 	// Start the path explorer ready for the next step. This can be very
 	// computationally intensive, but intermittently so.
@@ -6041,6 +6189,7 @@ void karte_t::step()
 	// the path explorer would thus lead to a race condition.
 	start_convoy_threads();
 #endif
+	step_profiler_t::add_time(PHASE_START_THREADS, dr_time_us() - phase_start_us);
 
 	// ok, next step
 	INT_CHECK("karte_t::step 9");
@@ -6053,7 +6202,9 @@ void karte_t::step()
 	recalc_season_snowline(true);
 
 	// This is not particularly computationally intensive.
+	phase_start_us = dr_time_us();
 	step_time_interval_signals();
+	step_profiler_t::add_time(PHASE_SIGNALS, dr_time_us() - phase_start_us);
 
 	/** END OF THREADABLE AREA **/
 
@@ -6086,9 +6237,13 @@ void karte_t::step()
 	}
 
 	if(  get_scenario()->is_scripted() ) {
+		STEP_PROFILE(PHASE_SCENARIO);
 		get_scenario()->step();
 	} // Loss of synchronisation suspected to be in a block of code ending here.
 
+	step_profiler_t::add_time(PHASE_STEP, dr_time_us() - step_start_us);
+	step_profiler_t::end_step();
+
 	DBG_DEBUG4("karte_t::step", "end");
 	rands[26] = get_random_seed();
 }
@@ -6117,39 +6272,116 @@ void karte_t::clear_private_car_routes() {
 
 }
 
+void karte_t::schedule_time_interval_signal(signal_t* sig, sint64 tick)
+{
+	if(  sig->is_time_interval_queued()  &&  sig->get_time_interval_due() == tick  ) {
+		return;
+	}
+	// an earlier entry of this signal is skipped, as its tick does not match any more
+	sig->set_time_interval_queued(true);
+	sig->set_time_interval_due(tick);
+	time_interval_signals_to_check.insert(tick, sig);
+}
+
+void karte_t::add_time_interval_signal_to_check(signal_t* sig)
+{
+	// A train passing only moves the deadlines of a signal later, so an
+	// existing timer is early enough; it is set anew when it expires.
+	if(  !sig->is_time_interval_queued()  ) {
+		// check at the next step
+		schedule_time_interval_signal(sig, ticks - 1);
+	}
+}
+
+void karte_t::time_interval_signal_set_to_danger(signal_t* sig)
+{
+	// A signal at danger shows caution at the next step after its caution
+	// deadline. Checking it at the next step keeps the timers the same as
+	// they are rebuilt after loading, where all signals are checked at once.
+	if(  sig->get_time_interval_due() >= ticks  ) {
+		schedule_time_interval_signal(sig, ticks - 1);
+	}
+}
+
+bool karte_t::remove_time_interval_signal_to_check(signal_t* sig)
+{
+	if(  !sig->is_time_interval_queued()  ) {
+		return false;
+	}
+	sig->set_time_interval_queued(false);
+	return time_interval_signals_to_check.remove(sig);
+}
+
 void karte_t::step_time_interval_signals()
 {
-	if (!time_interval_signals_to_check.empty())
+	if (time_interval_signals_to_check.empty())
 	{
-		const sint64 caution_interval_ticks = get_seconds_to_ticks(settings.get_time_interval_seconds_to_caution());
-		const sint64 clear_interval_ticks = get_seconds_to_ticks(settings.get_time_interval_seconds_to_clear());
+		return;
+	}
 
-		for (vector_tpl<signal_t*>::iterator iter = time_interval_signals_to_check.begin(); iter != time_interval_signals_to_check.end();)
+	const sint64 caution_interval_ticks = get_seconds_to_ticks(settings.get_time_interval_seconds_to_caution());
+	const sint64 clear_interval_ticks = get_seconds_to_ticks(settings.get_time_interval_seconds_to_clear());
+
+	if (caution_interval_ticks != time_interval_caution_ticks || clear_interval_ticks != time_interval_clear_ticks)
+	{
+		// The settings or the scale changed: check every signal again.
+		vector_tpl<signal_t*> signals(time_interval_signals_to_check.get_count());
+		while (!time_interval_signals_to_check.empty())
 		{
-			signal_t* sig = *iter;
-			if (((sig->get_train_last_passed() + clear_interval_ticks) < ticks) && sig->get_no_junctions_to_next_signal())
+			signal_t* sig = time_interval_signals_to_check.pop();
+			if (sig->is_time_interval_queued())
 			{
-				iter = time_interval_signals_to_check.swap_erase(iter);
-				sig->set_state(roadsign_t::clear_no_choose);
+				// only once, even with outdated entries
+				sig->set_time_interval_queued(false);
+				signals.append(sig);
 			}
-			else if (sig->get_state() == roadsign_t::danger && ((sig->get_train_last_passed() + caution_interval_ticks) < ticks) && sig->get_no_junctions_to_next_signal())
-			{
-				if (sig->get_desc()->is_pre_signal())
-				{
-					sig->set_state(roadsign_t::clear_no_choose);
-				}
-				else
-				{
-					sig->set_state(roadsign_t::caution_no_choose);
-				}
+		}
+		FOR(vector_tpl<signal_t*>, sig, signals)
+		{
+			schedule_time_interval_signal(sig, ticks - 1);
+		}
+		time_interval_caution_ticks = caution_interval_ticks;
+		time_interval_clear_ticks = clear_interval_ticks;
+	}
 
-				++iter;
+	while (time_interval_signals_to_check.is_due(ticks))
+	{
+		const sint64 due = time_interval_signals_to_check.get_next_tick();
+		signal_t* sig = time_interval_signals_to_check.pop();
+		if (!sig->is_time_interval_queued() || sig->get_time_interval_due() != due)
+		{
+			// rescheduled or removed since
+			continue;
+		}
+		const sint64 caution_tick = sig->get_train_last_passed() + caution_interval_ticks;
+		const sint64 clear_tick = sig->get_train_last_passed() + clear_interval_ticks;
+
+		if ((clear_tick < ticks) && sig->get_no_junctions_to_next_signal())
+		{
+			sig->set_time_interval_queued(false);
+			sig->set_state(roadsign_t::clear_no_choose);
+			continue;
+		}
+		else if (sig->get_state() == roadsign_t::danger && (caution_tick < ticks) && sig->get_no_junctions_to_next_signal())
+		{
+			if (sig->get_desc()->is_pre_signal())
+			{
+				sig->set_state(roadsign_t::clear_no_choose);
 			}
 			else
 			{
-				++iter;
+				sig->set_state(roadsign_t::caution_no_choose);
 			}
 		}
+
+		// Wake up again when the next aspect is due. Without a clear path to
+		// the next signal this may change any time, so check every step then.
+		sint64 next_tick = ticks;
+		if (sig->get_no_junctions_to_next_signal())
+		{
+			next_tick = caution_tick >= ticks ? std::min(caution_tick, clear_tick) : clear_tick;
+		}
+		schedule_time_interval_signal(sig, next_tick);
 	}
 }
 
@@ -8282,6 +8514,36 @@ bool karte_t::is_water(koord k, koord dim) const
 }
 
 
+bool karte_t::square_tile_is_free(koord k_check, sint16 platz_h, climate_bits cl) const
+{
+	const grund_t *gr = lookup_kartenboden(k_check);
+
+	// we can built, if: max height all the same, everything removable and no buildings there
+	slope_t::type slope = gr->get_grund_hang();
+	sint8 max_height = gr->get_hoehe() + slope_t::max_diff(slope);
+
+	climate test_climate = get_climate(k_check);
+	if(  cl & (1 << water_climate)  &&  test_climate != water_climate  )
+	{
+		bool neighbour_water = false;
+		for(int i=0; i<8  &&  !neighbour_water; i++)
+		{
+			if(  is_within_limits(k_check + koord::neighbours[i])  &&  get_climate( k_check + koord::neighbours[i] ) == water_climate  )
+			{
+				neighbour_water = true;
+			}
+		}
+		if(  neighbour_water  )
+		{
+			test_climate = water_climate;
+		}
+	}
+	return !(  platz_h != max_height  ||  !gr->ist_natur()  ||  gr->kann_alle_obj_entfernen(NULL) != NULL  ||
+	     (cl & (1 << test_climate)) == 0  ||  ( slope && (lookup( gr->get_pos()+koord3d(0,0,1) ) ||
+	     (slope_t::max_diff(slope)==2 && lookup( gr->get_pos()+koord3d(0,0,2) )) ))  );
+}
+
+
 bool karte_t::square_is_free(koord k, sint16 w, sint16 h, int *last_y, climate_bits cl, uint16 regions_allowed) const
 {
 	if(k.x < 0  ||  k.y < 0  ||  k.x+w > get_size().x || k.y+h > get_size().y) {
@@ -8291,13 +8553,37 @@ bool karte_t::square_is_free(koord k, sint16 w, sint16 h, int *last_y, climate_b
 	grund_t *gr = lookup_kartenboden(k);
 	const sint16 platz_h = gr->get_grund_hang() ? max_hgt(k) : gr->get_hoehe();	// remember the max height of the first tile
 
+	if(  last_y == NULL  ) {
+		// The index names tiles which probably fail. If one really fails, the
+		// square is not free; otherwise the outdated tiles are corrected and
+		// the full check below decides. So the result never depends on the index.
+		// Tasks of a task_pool_t must not change the index.
+		const bool may_change_index = !task_pool_t::is_in_task();
+		if(  !free_area_index.is_built_for( get_size() )  &&  may_change_index  ) {
+			free_area_index.init( this );
+		}
+		koord found[2];
+		uint8 count;
+		while(  free_area_index.is_built_for( get_size() )  &&  (count = free_area_index.find_blocking_tiles( k, w, h, cl, found )) > 0  ) {
+			for(  uint8 i = 0;  i < count;  i++  ) {
+				if(  (1 << get_region( found[i] ) & regions_allowed) == 0  ||  !square_tile_is_free( found[i], platz_h, cl )  ) {
+					return false;
+				}
+			}
+			if(  !may_change_index  ) {
+				break;
+			}
+			for(  uint8 i = 0;  i < count;  i++  ) {
+				free_area_index.update( this, found[i] );
+			}
+		}
+	}
+
 	koord k_check;
 	for(k_check.y=k.y+h-1; k_check.y>=k.y; k_check.y--)
 	{
 		for(k_check.x=k.x; k_check.x<k.x+w; k_check.x++)
 		{
-			const grund_t *gr = lookup_kartenboden(k_check);
-
 			uint8 test_region = get_region(k_check);
 
 
@@ -8306,34 +8592,16 @@ bool karte_t::square_is_free(koord k, sint16 w, sint16 h, int *last_y, climate_b
 				return false;
 			}
 
-			// we can built, if: max height all the same, everything removable and no buildings there
-			slope_t::type slope = gr->get_grund_hang();
-			sint8 max_height = gr->get_hoehe() + slope_t::max_diff(slope);
-
-			climate test_climate = get_climate(k_check);
-			if(  cl & (1 << water_climate)  &&  test_climate != water_climate  )
-			{
-				bool neighbour_water = false;
-				for(int i=0; i<8  &&  !neighbour_water; i++)
-				{
-					if(  is_within_limits(k_check + koord::neighbours[i])  &&  get_climate( k_check + koord::neighbours[i] ) == water_climate  )
-					{
-						neighbour_water = true;
-					}
-				}
-				if(  neighbour_water  )
-				{
-					test_climate = water_climate;
-				}
-			}
-			if(  platz_h != max_height  ||  !gr->ist_natur()  ||  gr->kann_alle_obj_entfernen(NULL) != NULL  ||
-			     (cl & (1 << test_climate)) == 0  ||  ( slope && (lookup( gr->get_pos()+koord3d(0,0,1) ) ||
-			     (slope_t::max_diff(slope)==2 && lookup( gr->get_pos()+koord3d(0,0,2) )) ))  )
+			if(  !square_tile_is_free( k_check, platz_h, cl )  )
 			{
 				if(  last_y  )
 				{
 					*last_y = k_check.y;
 				}
+				else if(  !task_pool_t::is_in_task()  ) {
+					// in case the index missed it
+					free_area_index.update( this, k_check );
+				}
 				return false;
 			}
 		}
@@ -8342,17 +8610,31 @@ bool karte_t::square_is_free(koord k, sint16 w, sint16 h, int *last_y, climate_b
 }
 
 
-slist_tpl<koord> *karte_t::find_squares(sint16 w, sint16 h, climate_bits cl, uint16 regions_allowed, sint16 old_x, sint16 old_y) const
+/// number of columns of the map which find_squares() searches in one task
+static const sint16 square_search_columns = 16;
+
+/// a range of columns for find_squares()
+struct square_search_t
 {
-	slist_tpl<koord> * list = new slist_tpl<koord>();
+	const karte_t *welt;
+	sint16 w, h;
+	climate_bits cl;
+	uint16 regions_allowed;
+	sint16 old_x, old_y;
+	vector_tpl<koord> *found;
+};
+
+
+static void find_squares_task(void *ptr, uint32 task)
+{
+	const square_search_t *search = static_cast<const square_search_t *>(ptr);
+	const sint16 x_end = min( (task + 1) * square_search_columns, search->welt->get_size().x - search->w );
 	koord start;
 	int last_y;
-
-DBG_DEBUG("karte_t::finde_plaetze()","for size (%i,%i) in map (%i,%i)",w,h,get_size().x,get_size().y );
-	for(start.x=0; start.x<get_size().x-w; start.x++) {
-		for(start.y=start.x<old_x?old_y:0; start.y<get_size().y-h; start.y++) {
-			if(square_is_free(start, w, h, &last_y, cl, regions_allowed)) {
-				list->insert(start);
+	for(  start.x = task * square_search_columns;  start.x < x_end;  start.x++  ) {
+		for(  start.y = start.x < search->old_x ? search->old_y : 0;  start.y < search->welt->get_size().y - search->h;  start.y++  ) {
+			if(  search->welt->square_is_free( start, search->w, search->h, &last_y, search->cl, search->regions_allowed )  ) {
+				search->found[task].append( start );
 			}
 			else {
 				// Optimiert fuer groessere Felder, hehe!
@@ -8362,6 +8644,41 @@ DBG_DEBUG("karte_t::finde_plaetze()","for size (%i,%i) in map (%i,%i)",w,h,get_s
 			}
 		}
 	}
+}
+
+
+slist_tpl<koord> *karte_t::find_squares(sint16 w, sint16 h, climate_bits cl, uint16 regions_allowed, sint16 old_x, sint16 old_y) const
+{
+	slist_tpl<koord> * list = new slist_tpl<koord>();
+
+DBG_DEBUG("karte_t::finde_plaetze()","for size (%i,%i) in map (%i,%i)",w,h,get_size().x,get_size().y );
+	if(  get_size().x <= w  ) {
+		return list;
+	}
+
+	// the columns are searched in parallel, and the results put together in the same order as before
+	const uint32 tasks = (get_size().x - w + square_search_columns - 1) / square_search_columns;
+	vector_tpl<koord> *found = new vector_tpl<koord>[tasks];
+	square_search_t search;
+	search.welt = this;
+	search.w = w;
+	search.h = h;
+	search.cl = cl;
+	search.regions_allowed = regions_allowed;
+	search.old_x = old_x;
+	search.old_y = old_y;
+	search.found = found;
+	{
+		task_pool_t pool( env_t::num_threads );
+		pool.run( find_squares_task, &search, tasks );
+	}
+
+	for(  uint32 t = 0;  t < tasks;  t++  ) {
+		FOR( vector_tpl<koord>, const& k, found[t] ) {
+			list->insert( k );
+		}
+	}
+	delete [] found;
 	return list;
 }
 
@@ -9900,6 +10217,13 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 
 	ls.set_progress( (get_size().y*3)/2+256+(get_size().y*3)/8 );
 
+	// the reservations were read with the ways, before their convoys
+	FOR(vector_tpl<weg_t*>, const way, weg_t::get_alle_wege()) {
+		if(  way->is_rail_type()  ||  way->get_waytype() == air_wt  ) {
+			static_cast<schiene_t*>(way)->register_loaded_reservation();
+		}
+	}
+
 	// adding lines and other stuff for convois
 	for(unsigned i=0;  i<convoi_array.get_count();  i++ ) {
 		convoihandle_t cnv = convoi_array[i];
@@ -10266,6 +10590,18 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 }
 
 
+// production step of the factories within the given part of the map (for world_xy_loop)
+void karte_t::step_factories_production(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
+{
+	FOR(vector_tpl<fabrik_t*>, const f, fab_list) {
+		const koord k = f->get_pos().get_2d();
+		if(  k.x >= x_min  &&  k.x < x_max  &&  k.y >= y_min  &&  k.y < y_max  ) {
+			f->step_production(factories_delta_t);
+		}
+	}
+}
+
+
 // recalcs all ground tiles on the map
 void karte_t::update_map_intern(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
 {
@@ -10406,6 +10742,7 @@ void karte_t::calc_climate(koord k, bool recalc)
 		}
 		pl->set_climate_transition_flag(false);
 		pl->set_climate_corners(0);
+		update_free_area( k );
 	}
 
 	if(  recalc  ) {
@@ -12596,3 +12933,28 @@ uint32 karte_t::get_gamestate_hash()
 	rdwr_gamestate(&ls, NULL);
 	return stream->get_hash();
 }
+
+
+checklist_t karte_t::run_benchmark_steps(uint32 count)
+{
+	const uint8 old_step_mode = step_mode;
+	// FIX_RATIO also disables the interrupt, so INT_CHECK will not draw anything
+	step_mode = FIX_RATIO;
+	reset_timer();
+
+	network_frame_count = 0;
+	const uint32 delta_t = (fix_ratio_frame_time * time_multiplier) / 16;
+	for(  uint32 i = 0;  i < count;  i++  ) {
+		for(  uint8 frame = 0;  frame < settings.get_frames_per_step();  frame++  ) {
+			sync_step( delta_t, true, false );
+		}
+		set_random_mode( STEP_RANDOM );
+		step();
+		clear_random_mode( STEP_RANDOM );
+	}
+	sync_steps = steps * settings.get_frames_per_step();
+
+	step_mode = old_step_mode;
+	reset_timer();
+	return checklist_t( sync_steps, (uint32)steps, network_frame_count, get_random_seed(), halthandle_t::get_next_check(), linehandle_t::get_next_check(), convoihandle_t::get_next_check(), rands, debug_sums );
+}
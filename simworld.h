@@ -17,12 +17,14 @@
 #include "tpl/weighted_vector_tpl.h"
 #include "tpl/vector_tpl.h"
 #include "tpl/slist_tpl.h"
+#include "tpl/timer_heap_tpl.h"
 #include "tpl/koordhashtable_tpl.h"
 
 #include "dataobj/settings.h"
 #include "network/pwd_hash.h"
 #include "dataobj/loadsave.h"
 #include "dataobj/rect.h"
+#include "dataobj/free_area_index.h"
 
 #include "simware.h"
 #include "simplan.h"
@@ -76,9 +78,6 @@ class loadingscreen_t;
 #ifndef FORBID_MULTI_THREAD_PATH_EXPLORER
 #define MULTI_THREAD_PATH_EXPLORER
 #endif
-#ifndef FORBID_MULTI_THREAD_ROUTE_UNRESERVER
-#define MULTI_THREAD_ROUTE_UNRESERVER
-#endif
 #endif
 
 #ifndef FORBID_MULTI_THREAD_PASSENGER_GENERATION_IN_NETWORK_MODE
@@ -821,6 +820,13 @@ private:
 	 */
 	void update_underground_intern(sint16, sint16, sint16, sint16);
 
+	/**
+	 * Production and consumption of all factories within the region.
+	 * Called in parallel from step(), the distribution follows serially.
+	 */
+	void step_factories_production(sint16, sint16, sint16, sint16);
+	uint32 factories_delta_t;
+
 	/**
 	 * This contains all buildings in the world from which passenger
 	 * journeys ultimately start, weighted by their level.
@@ -862,9 +868,16 @@ private:
 	sint32 mail_step_interval;
 
 	// Signals in the time interval working method that need
-	// to be checked periodically to see whether they need
-	// to change to a less restrictive aspect.
-	vector_tpl<signal_t*> time_interval_signals_to_check;
+	// to change to a less restrictive aspect, due at the
+	// next tick when their aspect may change.
+	timer_heap_tpl<signal_t*> time_interval_signals_to_check;
+
+	// The intervals the timers were calculated with
+	sint64 time_interval_caution_ticks = -1;
+	sint64 time_interval_clear_ticks = -1;
+
+	// (Re)sets the timer of a signal; earlier entries of it are skipped
+	void schedule_time_interval_signal(signal_t* sig, sint64 tick);
 
 	// Do not repeat sounds from the same types of vehicles
 	// too often, so store the time when the next sound from
@@ -902,9 +915,7 @@ private:
 	bool private_car_threads_working;
 public:
 	static simthread_barrier_t step_convoys_barrier_external;
-	static simthread_barrier_t unreserve_route_barrier;
 	static simthread_barrier_t private_car_barrier;
-	static pthread_mutex_t unreserve_route_mutex;
 	static pthread_mutex_t step_passengers_and_mail_mutex;
 	static bool private_car_route_mutex_initialised;
 	static pthread_mutex_t private_car_route_mutex;
@@ -952,7 +963,6 @@ private:
 	static sint32 cities_to_process;
 #ifdef MULTI_THREAD
 	friend void *check_road_connexions_threaded(void* args);
-	friend void *unreserve_route_threaded(void* args);
 	friend void *step_passengers_and_mail_threaded(void* args);
 	friend void *step_convoys_threaded(void* args);
 	friend void *path_explorer_threaded(void* args);
@@ -1554,6 +1564,9 @@ private:
 	 */
 	mutable uint32 movement_denominator_shift;
 
+	/// hints for square_is_free(), built by its first call
+	mutable free_area_index_t free_area_index;
+
 	/*
 	 * Cache constant factors involved in walking time
 	 * These can only be set once, not changed after world creation
@@ -1797,6 +1810,7 @@ public:
 		planquadrat_t *plan = access(k);
 		if(  plan  ) {
 			plan->set_climate(cl);
+			update_free_area( k );
 			if(  recalc  ) {
 				recalc_transitions(k);
 				for(  int i = 0;  i < 8;  i++  ) {
@@ -2433,6 +2447,18 @@ public:
 	 */
 	bool square_is_free(koord k, sint16 w, sint16 h, int *last_y, climate_bits cl, uint16 regions_allowed) const;
 
+	/**
+	 * To be called after the ground, the ways, the halt or the climate of
+	 * the tile k changed, to keep the hints of square_is_free() up to date.
+	 */
+	void update_free_area(koord k) const { free_area_index.update( this, k ); }
+
+private:
+	/// the checks of square_is_free() for one tile, except the region
+	bool square_tile_is_free(koord k_check, sint16 platz_h, climate_bits cl) const;
+
+public:
+
 	/**
 	 * @return A list of all buildable squares with size w, h.
 	 * @note Only used for town creation at the moment.
@@ -2547,6 +2573,15 @@ public:
 	 */
 	uint32 get_gamestate_hash();
 
+	/**
+	 * Headless benchmark: runs count steps as fast as possible the way a
+	 * network game does (fixed frame time, frames_per_step sync steps per
+	 * step), but without display and without network.
+	 * @return the checklist after the last step; it is the same for every
+	 * run from the same savegame as long as the simulation is deterministic.
+	 */
+	checklist_t run_benchmark_steps(uint32 count);
+
 	/**
 	 * Time printing routines.
 	 * Should be inlined.
@@ -2596,8 +2631,10 @@ public:
 	double get_forge_cost(waytype_t waytype, koord3d position);
 	bool is_forge_cost_reduced(waytype_t waytype, koord3d position);
 
-	inline void add_time_interval_signal_to_check(signal_t* sig) { time_interval_signals_to_check.append_unique(sig); }
-	inline bool remove_time_interval_signal_to_check(signal_t* sig) { return time_interval_signals_to_check.remove(sig); }
+	void add_time_interval_signal_to_check(signal_t* sig);
+	bool remove_time_interval_signal_to_check(signal_t* sig);
+	/// a queued signal was set to danger, see roadsign_t::set_state()
+	void time_interval_signal_set_to_danger(signal_t* sig);
 
 	void calc_max_vehicle_speeds();
 
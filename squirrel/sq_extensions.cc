@@ -53,3 +53,9 @@ SQRESULT sq_resumevm(HSQUIRRELVM v, SQBool retval, SQInteger ops)
 
 	return ret;
 }
+
+bool sq_is_out_of_ops(HSQUIRRELVM v)
+{
+	// the vm only suspends itself with negative remaining ops
+	return sq_getvmstate(v) == SQ_VMSTATE_SUSPENDED  &&  v->_ops_remaining < 0;
+}
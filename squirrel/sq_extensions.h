@@ -36,4 +36,10 @@ SQRESULT sq_call_restricted(HSQUIRRELVM v, SQInteger params, SQBool retval, SQBo
  */
 SQRESULT sq_resumevm(HSQUIRRELVM v, SQBool retval, SQInteger ops = 1000);
 
+/**
+ * @returns true if the vm is suspended because its opcode limit was exceeded,
+ * false if it is not suspended or suspended itself (e.g. waiting for a tool).
+ */
+bool sq_is_out_of_ops(HSQUIRRELVM v);
+
 #endif
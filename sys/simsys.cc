@@ -9,6 +9,7 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <chrono>
 
 #ifdef __HAIKU__
 #include <Message.h>
@@ -975,6 +976,12 @@ const char *dr_get_locale_string()
 #endif
 
 
+uint64 dr_time_us()
+{
+	return (uint64)std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
 void dr_fatal_notify(char const* const msg)
 {
 	fprintf(stderr, "dr_fatal_notify: ERROR: %s\n", msg);
@@ -167,6 +167,9 @@ void GetEvents();
 uint32 dr_time();
 void dr_sleep(uint32 millisec);
 
+/// monotonic time in microseconds, for profiling and benchmarks (not for game logic)
+uint64 dr_time_us();
+
 // error message in case of fatal events
 void dr_fatal_notify(char const* msg);
 
@@ -16,17 +16,33 @@
 #endif
 
 #include <signal.h>
+#include <string.h>
 
 #include "../macros.h"
 #include "../simdebug.h"
 #include "../simevent.h"
+#include "../display/simgraph.h"
 #include "simsys.h"
 
 
 static bool sigterm_received = false;
 
-#if COLOUR_DEPTH != 0
-#error "Posix only compiles with color depth=0"
+#if COLOUR_DEPTH != 0 && COLOUR_DEPTH != 16
+#error "Posix only compiles with color depth=0 or 16"
+#endif
+
+#if COLOUR_DEPTH == 16
+/*
+ * With 16 bit colour depth there is still no display, but everything is
+ * drawn into this buffer in RGB565, e.g. for headless render benchmarks.
+ */
+static unsigned short *offscreen = NULL;
+
+// some routines want 16 pixel alignment
+static int offscreen_pitch(int w)
+{
+	return max((w + 15) & 0x7FF0, 16);
+}
 #endif
 
 // no autoscaling as we have no display ...
@@ -43,6 +59,67 @@ bool dr_os_init(const int*)
 	return true;
 }
 
+#if COLOUR_DEPTH == 16
+resolution dr_query_screen_resolution()
+{
+	// largest usual screen, 4K
+	resolution const res = { 3840, 2160 };
+	return res;
+}
+
+// open the "window"
+int dr_os_open(int w, int h, bool)
+{
+	const int pitch = offscreen_pitch(w);
+	offscreen = new unsigned short[pitch * h];
+	memset( offscreen, 0, pitch * h * sizeof(unsigned short) );
+	display_set_actual_width( w );
+	display_set_height( h );
+	DBG_MESSAGE("dr_os_open(posix)", "offscreen buffer %ix%i (pitch %i)", w, h, pitch );
+	return pitch;
+}
+
+
+void dr_os_close()
+{
+	delete [] offscreen;
+	offscreen = NULL;
+}
+
+// resizes screen
+int dr_textur_resize(unsigned short** const textur, int w, int h)
+{
+	const int pitch = offscreen_pitch(w);
+	delete [] offscreen;
+	offscreen = new unsigned short[pitch * h];
+	memset( offscreen, 0, pitch * h * sizeof(unsigned short) );
+	*textur = offscreen;
+	display_set_actual_width( w );
+	display_set_height( h );
+	return pitch;
+}
+
+
+unsigned short *dr_textur_init()
+{
+	return offscreen;
+}
+
+// RGB565
+unsigned int get_system_color(unsigned int r, unsigned int g, unsigned int b)
+{
+	return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+}
+
+void dr_prepare_flush()
+{
+}
+
+void dr_flush()
+{
+	display_flush_buffer();
+}
+#else
 resolution dr_query_screen_resolution()
 {
 	resolution const res = { 0, 0 };
@@ -85,6 +162,7 @@ void dr_prepare_flush()
 void dr_flush()
 {
 }
+#endif
 
 void dr_textur(int, int, int, int)
 {
@@ -0,0 +1,304 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ *
+ * Microbenchmark for hashtable_tpl.h
+ * Compares the open addressing hashtable_tpl with the former fixed bag
+ * implementation (chained_hashtable_tpl below, a copy of the old code) and
+ * checks that both agree and that the iteration order only depends on the
+ * keys contained.
+ * Do NOT link this into simutrans!  This is a standalone benchmark!
+ *
+ * Build with something like:
+ * g++ -O2 -std=c++11 -DMULTI_THREAD tpl/bench_hashtable_tpl.cc -lpthread -o bench_hashtable
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+
+#include "../simtypes.h"
+#include "inthashtable_tpl.h"
+#include "koordhashtable_tpl.h"
+#include "stringhashtable_tpl.h"
+#include "vector_tpl.h"
+
+// This is a hack, but it's worth it.  The templates need logging and memory in order to link.
+#include "../simdebug.cc"
+#include "../simmem.cc"
+#include "../dataobj/freelist.cc"
+#include "../utils/dumb-log.cc"
+
+
+/*
+ * The former hashtable: n_bags sorted single linked lists
+ */
+template<class key_t, class value_t, class hash_t, size_t n_bags>
+class chained_hashtable_tpl
+{
+	struct node_t {
+		key_t   key;
+		value_t value;
+		int operator == (const node_t &x) const { return key == x.key; }
+	};
+	slist_tpl<node_t> bags[n_bags];
+	uint32 count;
+
+	slist_tpl<node_t> &get_bag(const key_t key) { return bags[hash_t::hash(key) % n_bags]; }
+
+public:
+	chained_hashtable_tpl() : count(0) {}
+
+	value_t *access(const key_t key)
+	{
+		FORT(slist_tpl<node_t>, & node, get_bag(key)) {
+			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
+			if(  diff == 0  ) {
+				return &node.value;
+			}
+			if(  diff > 0  ) {
+				break;
+			}
+		}
+		return NULL;
+	}
+
+	bool put(const key_t key, value_t object)
+	{
+		slist_tpl<node_t>& bag = get_bag(key);
+		node_t n;
+		n.key   = key;
+		n.value = object;
+		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
+			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
+			if(  diff > 0  ) {
+				bag.insert( iter, n );
+				count ++;
+				return true;
+			}
+			if(  diff == 0  ) {
+				return false;
+			}
+		}
+		bag.append( n );
+		count ++;
+		return true;
+	}
+
+	value_t remove(const key_t key)
+	{
+		slist_tpl<node_t>& bag = get_bag(key);
+		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
+			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
+			if(  diff == 0  ) {
+				value_t v = iter->value;
+				bag.erase(iter);
+				count --;
+				return v;
+			}
+			if(  diff > 0  ) {
+				break;
+			}
+		}
+		return value_t();
+	}
+
+	uint64 sum_values() const
+	{
+		uint64 sum = 0;
+		for(  size_t i = 0;  i < n_bags;  i++  ) {
+			FORT(slist_tpl<node_t>, const& node, bags[i]) {
+				sum += node.value;
+			}
+		}
+		return sum;
+	}
+
+	uint32 get_count() const { return count; }
+};
+
+
+template<class table_t>
+static uint64 sum_values(const table_t &table)
+{
+	uint64 sum = 0;
+	FORT(table_t, const& i, table) {
+		sum += i.value;
+	}
+	return sum;
+}
+
+template<class key_t, class value_t, class hash_t, size_t n_bags>
+static uint64 sum_values(const chained_hashtable_tpl<key_t, value_t, hash_t, n_bags> &table)
+{
+	return table.sum_values();
+}
+
+
+static uint64 now_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+static uint32 check_sum = 0;
+
+/*
+ * Times put, successful and failing lookups, iteration and remove for the
+ * keys in hits (misses must not be contained in hits).
+ */
+template<class table_t, class key_t>
+static void run(const char *name, const vector_tpl<key_t> &hits, const vector_tpl<key_t> &misses, int repeat)
+{
+	uint64 t_put = 0, t_get = 0, t_miss = 0, t_iter = 0, t_remove = 0;
+	for(  int r = 0;  r < repeat;  r++  ) {
+		table_t *table = new table_t;
+
+		uint64 t = now_us();
+		for(  uint32 i = 0;  i < hits.get_count();  i++  ) {
+			table->put( hits[i], i );
+		}
+		t_put += now_us() - t;
+
+		t = now_us();
+		for(  uint32 i = 0;  i < hits.get_count();  i++  ) {
+			check_sum += *table->access( hits[i] );
+		}
+		t_get += now_us() - t;
+
+		t = now_us();
+		for(  uint32 i = 0;  i < misses.get_count();  i++  ) {
+			check_sum += table->access( misses[i] ) != NULL;
+		}
+		t_miss += now_us() - t;
+
+		t = now_us();
+		check_sum += (uint32)sum_values( *table );
+		t_iter += now_us() - t;
+
+		t = now_us();
+		for(  uint32 i = 0;  i < hits.get_count();  i++  ) {
+			check_sum += table->remove( hits[i] );
+		}
+		t_remove += now_us() - t;
+
+		if(  table->get_count() != 0  ) {
+			printf( "%s: table not empty after removing all keys!\n", name );
+			exit( 1 );
+		}
+		delete table;
+	}
+	const double n = (double)hits.get_count() * repeat / 1000.0;
+	printf( "%-28s %8u keys: put %7.1f  get %7.1f  miss %7.1f  iterate %7.1f  remove %7.1f ns/key\n",
+		name, hits.get_count(), t_put / n, t_get / n, t_miss / n, t_iter / n, t_remove / n );
+	fflush( stdout );
+}
+
+
+static uint32 rng_state = 12345;
+static uint32 rng()
+{
+	rng_state ^= rng_state << 13;
+	rng_state ^= rng_state >> 17;
+	rng_state ^= rng_state << 5;
+	return rng_state;
+}
+
+
+/*
+ * Puts the same keys in different order and with removals in between and
+ * checks that the resulting iteration order is the same.
+ */
+static bool check_iteration_order()
+{
+	typedef inthashtable_tpl<uint32, uint32, N_BAGS_LARGE> table_t;
+	vector_tpl<uint32> keys;
+	for(  uint32 i = 0;  i < 5000;  i++  ) {
+		keys.append( rng() % 100000 );
+	}
+
+	table_t a, b;
+	for(  uint32 i = 0;  i < keys.get_count();  i++  ) {
+		a.set( keys[i], i );
+	}
+	// b sees the keys backwards, grows further and shrinks again
+	for(  uint32 i = 0;  i < 20000;  i++  ) {
+		b.set( 200000 + i, i );
+	}
+	for(  uint32 i = keys.get_count();  i-- > 0;  ) {
+		b.set( keys[i], i );
+	}
+	for(  uint32 i = 0;  i < 20000;  i++  ) {
+		b.remove( 200000 + i );
+	}
+
+	if(  a.get_count() != b.get_count()  ) {
+		return false;
+	}
+	table_t const &ca = a, &cb = b;
+	table_t::const_iterator ia = ca.begin(), ib = cb.begin();
+	for(  ;  ia != ca.end()  &&  ib != cb.end();  ++ia, ++ib  ) {
+		if(  ia->key != ib->key  ) {
+			return false;
+		}
+	}
+	return ia == ca.end()  &&  ib == cb.end();
+}
+
+
+int main()
+{
+	init_logging( "stderr", true, true, NULL, NULL );
+
+	printf( "iteration order independent of history: %s\n", check_iteration_order() ? "ok" : "FAILED" );
+
+	static const uint32 sizes[] = { 100, 1000, 10000, 100000, 1000000 };
+	for(  size_t s = 0;  s < lengthof(sizes);  s++  ) {
+		const uint32 size = sizes[s];
+		const int repeat = max( 1, 1000000 / (int)size );
+
+		// integer keys, like ids
+		vector_tpl<uint32> int_hits( size ), int_misses( size );
+		for(  uint32 i = 0;  i < size;  i++  ) {
+			int_hits.append( i * 2 );
+			int_misses.append( i * 2 + 1 );
+		}
+		run< inthashtable_tpl<uint32, uint32, N_BAGS_LARGE> >( "inthashtable_tpl", int_hits, int_misses, repeat );
+		if(  size <= 100000  ) {
+			// quadratic, would take ages with more keys
+			run< chained_hashtable_tpl<uint32, uint32, inthash_tpl<uint32>, N_BAGS_LARGE> >( "  former, N_BAGS_LARGE", int_hits, int_misses, repeat );
+		}
+
+		// koords, like haltestelle_t::all_koords
+		vector_tpl<koord> koord_hits( size ), koord_misses( size );
+		const sint16 width = (sint16)(sqrt( (double)size ) + 1);
+		for(  uint32 i = 0;  i < size;  i++  ) {
+			koord_hits.append( koord( (sint16)(i % width), (sint16)(i / width) ) );
+			koord_misses.append( koord( (sint16)(i % width), (sint16)(i / width + width + 1) ) );
+		}
+		run< koordhashtable_tpl<koord, uint32, N_BAGS_LARGE> >( "koordhashtable_tpl", koord_hits, koord_misses, repeat );
+		if(  size <= 100000  ) {
+			run< chained_hashtable_tpl<koord, uint32, koordhash_tpl<koord>, N_BAGS_LARGE> >( "  former, N_BAGS_LARGE", koord_hits, koord_misses, repeat );
+		}
+
+		// strings, like the name tables
+		if(  size <= 100000  ) {
+			vector_tpl<const char *> str_hits( size ), str_misses( size );
+			for(  uint32 i = 0;  i < size;  i++  ) {
+				char buf[32];
+				sprintf( buf, "city_%u_station", i );
+				str_hits.append( strdup( buf ) );
+				sprintf( buf, "city_%u_depot", i );
+				str_misses.append( strdup( buf ) );
+			}
+			run< stringhashtable_tpl<uint32, N_BAGS_LARGE> >( "stringhashtable_tpl", str_hits, str_misses, repeat );
+			run< chained_hashtable_tpl<const char *, uint32, stringhash_t, N_BAGS_LARGE> >( "  former, N_BAGS_LARGE", str_hits, str_misses, repeat );
+			for(  uint32 i = 0;  i < size;  i++  ) {
+				free( (void *)str_hits[i] );
+				free( (void *)str_misses[i] );
+			}
+		}
+	}
+	printf( "(checksum %u)\n", check_sum );
+	return 0;
+}
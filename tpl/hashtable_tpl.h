@@ -7,17 +7,38 @@
 #define TPL_HASHTABLE_TPL_H
 
 
+#include <string.h>
+#include <iterator>
+
 #include "slist_tpl.h"
+#include "../dataobj/freelist.h"
+#include "../simdebug.h"
 #include "../macros.h"
 
-#define STHT_BAGSIZE 3
-#define STHT_BAG_COUNTER_T uint8
+// smallest table allocated on first insertion (log2)
+#define HT_MIN_BITS 3
 
 
 /*
  * Generic hashtable, which maps key_t to value_t. key_t depended functions
  * like the hash generation is implemented by the third template parameter
  * hash_t (see ifc/hash_tpl.h)
+ *
+ * This is an open addressing table with linear probing. The slots are kept
+ * sorted by (mixed hash, key), i.e. every entry sits at or behind its home
+ * slot and runs are ordered like in a robin hood table. There is no wrap
+ * around; instead a short overflow area follows the power of two sized
+ * table. As a consequence, the iteration order only depends on the set of
+ * keys contained and neither on the order of insertion nor on the table
+ * size. This is important for network games, where a client rebuilding a
+ * table from a savegame must iterate in the same order as the server.
+ *
+ * The table grows when it is filled to 3/4. Entries are allocated
+ * separately, so pointers returned by access() stay valid until the entry
+ * is removed, and values need not to be copyable.
+ *
+ * n_bags is kept for source compatibility only; it does not influence the
+ * memory used any more. An empty table does not allocate anything.
  */
 template<class key_t, class value_t, class hash_t, size_t n_bags>
 class hashtable_tpl
@@ -29,11 +50,20 @@ protected:
 		value_t value;
 
 		int operator == (const node_t &x) const { return key == x.key; }
+
+		void* operator new(size_t) { return freelist_t::gimme_node(sizeof(node_t)); }
+		void operator delete(void* p) { freelist_t::putback_node(sizeof(node_t), p); }
+	};
+
+	struct slot_t {
+		uint32  hash; // mixed hash; the upper bits give the home slot
+		node_t *node; // NULL for empty slots
 	};
 
-	// the entires in the lists are sorted according to their keys
-	slist_tpl <node_t> bags[n_bags];
+	slot_t *slots;
+	uint32 n_slots; // table size plus overflow area
 	uint32 count;
+	uint8 bits;     // log2 of table size without overflow area
 
 /*
  * assigning hashtables seems also not sound
@@ -42,13 +72,132 @@ private:
 	hashtable_tpl(const hashtable_tpl&);
 	hashtable_tpl& operator=( hashtable_tpl const&);
 
-public:
-	hashtable_tpl() { count = 0; }
+	// Fibonacci hashing: spreads the often rather regular hashes (koords, ids) over the upper bits
+	static uint32 mix_hash(const key_t &key) { return (uint32)hash_t::hash(key) * 0x9E3779B9u; }
+
+	uint32 home(uint32 hash) const { return hash >> (32 - bits); }
+
+	/*
+	 * Returns the slot containing key, or, if not found, the slot where it
+	 * must be inserted to keep the order (may be n_slots).
+	 */
+	uint32 find_slot(uint32 hash, const key_t &key, bool &found) const
+	{
+		found = false;
+		if(  slots == NULL  ) {
+			return 0;
+		}
+		uint32 i = home(hash);
+		for(  ;  i < n_slots  &&  slots[i].node;  i++  ) {
+			if(  slots[i].hash < hash  ) {
+				continue;
+			}
+			if(  slots[i].hash > hash  ) {
+				break;
+			}
+			typename hash_t::diff_type diff = hash_t::comp(slots[i].node->key, key);
+			if(  diff == 0  ) {
+				found = true;
+				break;
+			}
+			if(  diff > 0  ) {
+				break;
+			}
+		}
+		return i;
+	}
+
+	/*
+	 * Rebuilds the table with 2^new_bits slots and an overflow area of at
+	 * least tail slots. Since the old slots are already sorted, each entry
+	 * just goes to its home or behind its predecessor.
+	 */
+	void resize(uint8 new_bits, uint32 tail)
+	{
+		for(;;) {
+			const uint32 new_n_slots = (1u << new_bits) + tail;
+			slot_t *new_slots = new slot_t[new_n_slots];
+			MEMZERON( new_slots, new_n_slots );
+
+			bool fits = true;
+			uint32 pos = 0;
+			for(  uint32 i = 0;  i < n_slots;  i++  ) {
+				if(  slots[i].node  ) {
+					const uint32 new_home = slots[i].hash >> (32 - new_bits);
+					if(  pos < new_home  ) {
+						pos = new_home;
+					}
+					if(  pos >= new_n_slots  ) {
+						fits = false;
+						break;
+					}
+					new_slots[pos++] = slots[i];
+				}
+			}
+
+			if(  fits  ) {
+				delete [] slots;
+				slots = new_slots;
+				n_slots = new_n_slots;
+				bits = new_bits;
+				return;
+			}
+			// too many entries at the very end: retry with a larger overflow area
+			delete [] new_slots;
+			tail *= 2;
+		}
+	}
+
+	/*
+	 * Links node into its place in the sorted order, shifting the rest of
+	 * the run by one. Grows the table as needed.
+	 */
+	void insert_node(uint32 hash, node_t *node)
+	{
+		if(  slots == NULL  ||  (count + 1) * 4 > (3u << bits)  ) {
+			const uint8 new_bits = slots ? bits + 1 : HT_MIN_BITS;
+			resize( new_bits, new_bits + 1 );
+		}
+		for(;;) {
+			bool found;
+			const uint32 pos = find_slot( hash, node->key, found );
+			uint32 empty = pos;
+			while(  empty < n_slots  &&  slots[empty].node  ) {
+				empty++;
+			}
+			if(  empty < n_slots  ) {
+				memmove( slots + pos + 1, slots + pos, sizeof(slot_t) * (empty - pos) );
+				slots[pos].hash = hash;
+				slots[pos].node = node;
+				count++;
+				return;
+			}
+			// ran off the end of the overflow area
+			resize( bits, (n_slots - (1u << bits)) * 2 );
+		}
+	}
+
+	/*
+	 * Empties slot pos (backward shift deletion). The node is not freed.
+	 */
+	void unlink_slot(uint32 pos)
+	{
+		uint32 end = pos + 1;
+		while(  end < n_slots  &&  slots[end].node  &&  home(slots[end].hash) < end  ) {
+			end++;
+		}
+		memmove( slots + pos, slots + pos + 1, sizeof(slot_t) * (end - pos - 1) );
+		slots[end - 1].node = NULL;
+		count--;
+	}
 
 public:
-	STHT_BAG_COUNTER_T get_hash(const key_t key) const
+	hashtable_tpl() : slots(NULL), n_slots(0), count(0), bits(0) {}
+
+	~hashtable_tpl()
 	{
-		return (STHT_BAG_COUNTER_T)(hash_t::hash(key) % n_bags);
+		clear();
+		delete [] slots;
 	}
 
 	class iterator
@@ -61,41 +210,38 @@ public:
 			typedef node_t*                   pointer;
 			typedef node_t&                   reference;
 
-			iterator() : bag_i(), bag_end(), node_i() {}
+			iterator() : slot_i(), slot_end() {}
 
-			iterator(slist_tpl<node_t>* const bag_i,  slist_tpl<node_t>* const bag_end, typename slist_tpl<node_t>::iterator const& node_i) :
-				bag_i(bag_i),
-				bag_end(bag_end),
-				node_i(node_i)
-			{}
+			iterator(slot_t* const slot_i, slot_t* const slot_end) :
+				slot_i(slot_i),
+				slot_end(slot_end)
+			{
+				skip_empty();
+			}
 
-			pointer   operator ->() const { return &*node_i; }
-			reference operator *()  const { return  *node_i; }
+			pointer   operator ->() const { return  slot_i->node; }
+			reference operator *()  const { return *slot_i->node; }
 
 			iterator& operator ++()
 			{
-				if (++node_i == bag_i->end()) {
-					for (;;) {
-						if (++bag_i == bag_end) {
-							node_i = typename slist_tpl<node_t>::iterator();
-							break;
-						}
-						if (!bag_i->empty()) {
-							node_i = bag_i->begin();
-							break;
-						}
-					}
-				}
+				++slot_i;
+				skip_empty();
 				return *this;
 			}
 
-			bool operator ==(iterator const& o) const { return bag_i == o.bag_i && node_i == o.node_i; }
+			bool operator ==(iterator const& o) const { return slot_i == o.slot_i; }
 			bool operator !=(iterator const& o) const { return !(*this == o); }
 
 		private:
-			slist_tpl<node_t>*                   bag_i;
-			slist_tpl<node_t>*                   bag_end;
-			typename slist_tpl<node_t>::iterator node_i;
+			void skip_empty()
+			{
+				while(  slot_i != slot_end  &&  slot_i->node == NULL  ) {
+					++slot_i;
+				}
+			}
+
+			slot_t* slot_i;
+			slot_t* slot_end;
 	};
 
 	/* Erase element at pos
@@ -103,24 +249,11 @@ public:
 	 * An iterator pointing to the successor of the erased element is returned */
 	iterator erase(iterator old)
 	{
-		iterator pos(old);
-		pos.bag_end = old.bag_end;
-		pos.bag_i = old.bag_i;
-		pos.node_i = old.bag_i->erase( old.node_i );
-		if(  pos.node_i ==  pos.bag_i->end()  ) {
-			for (;;) {
-				if (++pos.bag_i == pos.bag_end) {
-					pos.node_i = typename slist_tpl<node_t>::iterator();
-					break;
-				}
-				if (!pos.bag_i->empty()) {
-					pos.node_i = pos.bag_i->begin();
-					break;
-				}
-			}
-		}
-		count --;
-		return pos;
+		const uint32 pos = (uint32)(old.slot_i - slots);
+		delete old.slot_i->node;
+		unlink_slot( pos );
+		// the successor was shifted into pos, or is the next used slot
+		return iterator( slots + pos, slots + n_slots );
 	}
 
 	class const_iterator
@@ -132,146 +265,103 @@ public:
 			typedef node_t const*             pointer;
 			typedef node_t const&             reference;
 
-			const_iterator() : bag_i(), bag_end(), node_i() {}
+			const_iterator() : slot_i(), slot_end() {}
 
-			const_iterator(slist_tpl<node_t> const* const bag_i,  slist_tpl<node_t> const* const bag_end, typename slist_tpl<node_t>::const_iterator const& node_i) :
-				bag_i(bag_i),
-				bag_end(bag_end),
-				node_i(node_i)
-			{}
+			const_iterator(slot_t const* const slot_i, slot_t const* const slot_end) :
+				slot_i(slot_i),
+				slot_end(slot_end)
+			{
+				skip_empty();
+			}
 
-			pointer   operator ->() const { return &*node_i; }
-			reference operator *()  const { return  *node_i; }
+			pointer   operator ->() const { return  slot_i->node; }
+			reference operator *()  const { return *slot_i->node; }
 
 			const_iterator& operator ++()
 			{
-				if (++node_i == bag_i->end()) {
-					for (;;) {
-						if (++bag_i == bag_end) {
-							node_i = typename slist_tpl<node_t>::const_iterator();
-							break;
-						}
-						if (!bag_i->empty()) {
-							node_i = bag_i->begin();
-							break;
-						}
-					}
-				}
+				++slot_i;
+				skip_empty();
 				return *this;
 			}
 
-			bool operator ==(const_iterator const& o) const { return bag_i == o.bag_i && node_i == o.node_i; }
+			bool operator ==(const_iterator const& o) const { return slot_i == o.slot_i; }
 			bool operator !=(const_iterator const& o) const { return !(*this == o); }
 
 		private:
-			slist_tpl<node_t> const*                   bag_i;
-			slist_tpl<node_t> const*                   bag_end;
-			typename slist_tpl<node_t>::const_iterator node_i;
+			void skip_empty()
+			{
+				while(  slot_i != slot_end  &&  slot_i->node == NULL  ) {
+					++slot_i;
+				}
+			}
+
+			slot_t const* slot_i;
+			slot_t const* slot_end;
 	};
 
 	iterator begin()
 	{
-		for (slist_tpl<node_t>* i = bags; i != endof(bags); ++i) {
-			if (!i->empty()) {
-				return iterator(i, endof(bags), i->begin());
-			}
-		}
-		return end();
+		return iterator(slots, slots + n_slots);
 	}
 
 	iterator end()
 	{
-		return iterator(endof(bags), endof(bags), typename slist_tpl<node_t>::iterator());
+		return iterator(slots + n_slots, slots + n_slots);
 	}
 
 	const_iterator begin() const
 	{
-		for (slist_tpl<node_t> const* i = bags; i != endof(bags); ++i) {
-			if (!i->empty()) {
-				return const_iterator(i, endof(bags), i->begin());
-			}
-		}
-		return end();
+		return const_iterator(slots, slots + n_slots);
 	}
 
 	const_iterator end() const
 	{
-		return const_iterator(endof(bags), endof(bags), typename slist_tpl<node_t>::iterator());
+		return const_iterator(slots + n_slots, slots + n_slots);
 	}
 
+	// frees all entries, but keeps the table allocated
 	void clear()
 	{
-		for(STHT_BAG_COUNTER_T i=0; i<n_bags; i++) {
-			bags[i].clear();
+		for(  uint32 i = 0;  i < n_slots;  i++  ) {
+			if(  slots[i].node  ) {
+				delete slots[i].node;
+				slots[i].node = NULL;
+			}
 		}
 		count = 0;
 	}
 
-	// the elements are inserted with increasing key
-	// => faster retrieval (we only have to check half of the lists)
 	const value_t &get(const key_t key) const
 	{
 		static value_t nix;
-		FORT(slist_tpl<node_t>, const& node, bags[get_hash(key)]) {
-			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
-			if(  diff == 0  ) {
-				return node.value;
-			}
-			if(  diff > 0  ) {
-				// not contained
-				break;
-			}
-		}
-		return nix;
+		bool found;
+		const uint32 pos = find_slot( mix_hash(key), key, found );
+		return found ? slots[pos].node->value : nix;
 	}
 
-	// the elements are inserted with increasing key
-	// => faster retrivial, but never ever change a key later!!!
+	// never ever change a key later!!!
 	value_t *access(const key_t key)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-		FORT(slist_tpl<node_t>, & node, bag) {
-			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
-			if(  diff == 0  ) {
-				return &node.value;
-			}
-			if(  diff > 0  ) {
-				// not contained
-				break;
-			}
-		}
-		return NULL;
+		bool found;
+		const uint32 pos = find_slot( mix_hash(key), key, found );
+		return found ? &slots[pos].node->value : NULL;
 	}
 
 	/// Inserts a new value - failure if key exists in table
 	bool put(const key_t key, value_t object)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-
-		/* Duplicate values are hard to debug, so better check here.
-		 * we also enter it sorted, saving lookout time for large lists ...
-		 */
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff>0  ) {
-				node_t n;
-				n.key   = key;
-				n.value = object;
-				bag.insert( iter, n );
-				count ++;
-				return true;
-			}
-			if(  diff == 0  ) {
-				//dbg->message( "hashtable_tpl::put", "Duplicate hash!" );
-				return false;
-			}
+		const uint32 hash = mix_hash(key);
+		bool found;
+		find_slot( hash, key, found );
+		if(  found  ) {
+			/* Duplicate values are hard to debug, so better check here. */
+			//dbg->message( "hashtable_tpl::put", "Duplicate hash!" );
+			return false;
 		}
-		// here only for empty lists or everything was smaller
-		node_t n;
-		n.key = key;
-		n.value = object;
-		bag.append( n );
-		count ++;
+		node_t *node = new node_t();
+		node->key   = key;
+		node->value = object;
+		insert_node( hash, node );
 		return true;
 	}
 
@@ -282,18 +372,9 @@ public:
 	//
 	bool is_contained(const key_t key) const
 	{
-		const slist_tpl<node_t>& bag = bags[get_hash(key)];
-		FORT(slist_tpl<node_t>, const& node, bag) {
-			typename hash_t::diff_type diff = hash_t::comp(node.key, key);
-			if(  diff == 0  ) {
-				return true;
-			}
-			if(  diff > 0  ) {
-				// not contained
-				break;
-			}
-		}
-		return false;
+		bool found;
+		find_slot( mix_hash(key), key, found );
+		return found;
 	}
 
 	// Inserts a new instantiated value - failure, if key exists in table
@@ -301,28 +382,16 @@ public:
 	//
 	bool put(const key_t key)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-
-		/* Duplicate values are hard to debug, so better check here.
-		 * we also enter it sorted, saving lookout time for large lists ...
-		 */
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff>0  ) {
-				iter = bag.insert( iter );
-				iter->key = key;
-				count ++;
-				return true;
-			}
-			if(  diff == 0  ) {
-				// already initialized
-				return false;
-			}
+		const uint32 hash = mix_hash(key);
+		bool found;
+		find_slot( hash, key, found );
+		if(  found  ) {
+			// already initialized
+			return false;
 		}
-		// here only for empty lists or everything was smaller
-		bag.append();
-		bag.back().key = key;
-		count ++;
+		node_t *node = new node_t();
+		node->key = key;
+		insert_node( hash, node );
 		return true;
 	}
 
@@ -333,29 +402,18 @@ public:
 	//
 	value_t set(const key_t key, value_t object)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff == 0  ) {
-				value_t value = iter->value;
-				iter->value = object;
-				return value;
-			}
-			if(  diff > 0  ) {
-				node_t node;
-				node.key   = key;
-				node.value = object;
-				bag.insert( iter, node );
-				count ++;
-				return value_t();
-			}
+		const uint32 hash = mix_hash(key);
+		bool found;
+		const uint32 pos = find_slot( hash, key, found );
+		if(  found  ) {
+			value_t value = slots[pos].node->value;
+			slots[pos].node->value = object;
+			return value;
 		}
-		// empty list or really last one ...
-		node_t node;
-		node.key   = key;
-		node.value = object;
-		bag.append(node);
-		count ++;
+		node_t *node = new node_t();
+		node->key   = key;
+		node->value = object;
+		insert_node( hash, node );
 		return value_t();
 	}
 
@@ -363,33 +421,27 @@ public:
 	// otherwise the value that was associated to the key.
 	value_t remove(const key_t key)
 	{
-		slist_tpl<node_t>& bag = bags[get_hash(key)];
-		for(  typename slist_tpl<node_t>::iterator iter = bag.begin(), end = bag.end();  iter != end;  ++iter  ) {
-			typename hash_t::diff_type diff = hash_t::comp(iter->key, key);
-			if(  diff == 0  ) {
-				value_t v = iter->value;
-				bag.erase(iter);
-				count --;
-				return v;
-			}
-			if(  diff > 0  ) {
-				// not in list
-				break;
-			}
+		bool found;
+		const uint32 pos = find_slot( mix_hash(key), key, found );
+		if(  !found  ) {
+			return value_t();
 		}
-		return value_t();
+		node_t *node = slots[pos].node;
+		value_t v = node->value;
+		unlink_slot( pos );
+		delete node;
+		return v;
 	}
 
 	value_t remove_first()
 	{
-		for(STHT_BAG_COUNTER_T i = 0; i < n_bags; i++) {
-			if(  !bags[i].empty()  ) {
-				count --;
-				return bags[i].remove_first().value;
-			}
+		iterator first = begin();
+		if(  first == end()  ) {
+			dbg->fatal( "hashtable_tpl::remove_first()", "Hashtable already empty!" );
 		}
-		dbg->fatal( "hashtable_tpl::remove_first()", "Hashtable already empty!" );
-		return value_t();
+		value_t v = first->value;
+		erase( first );
+		return v;
 	}
 
 	uint32 get_count() const
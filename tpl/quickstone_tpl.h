@@ -7,6 +7,8 @@
 #define TPL_QUICKSTONE_TPL_H
 
 
+#include <string.h>
+
 #include "../simtypes.h"
 #include "../simdebug.h"
 
@@ -18,6 +20,11 @@
  * to leave freed  tombstones untouched as long as possible, to
  * detect most of the dangling pointers.
  *
+ * New handles take entries which were never used before, as long as the
+ * table can grow. Once it cannot, freed entries are reused in the order
+ * they were freed, from a list linked through the table, so no handle
+ * needs a search through the table.
+ *
  * This templates goal is to be efficient and fairly safe.
  */
 template <class T> class quickstone_tpl
@@ -28,6 +35,19 @@ private:
 	 */
 	static T ** data;
 
+	/**
+	 * For each entry the next freed entry (0 at the end of the list),
+	 * or NOT_LISTED for entries which are not in the list of freed entries.
+	 * Entries in the list may have been taken again in the meantime.
+	 */
+	static uint16 *free_links;
+
+	/**
+	 * First and last freed entry, 0 if none
+	 */
+	static uint16 free_head;
+	static uint16 free_tail;
+
 	/**
 	 * Next entry to check
 	 */
@@ -44,38 +64,78 @@ private:
 	 */
 	uint16 entry;
 
+	enum { NOT_LISTED = 65535 };
+
 private:
 	/**
 	 * Retrieves next free tombstone index
 	 */
 	static uint16 find_next() {
-		uint16 i;
-
-		// scan rest of array
-		for(  i=next;  i<size;  i++  ) {
-			if(  data[i] == 0  ) {
-				next = i+1;
-				return i;
+		// never used entries at the end of the array
+		while(  next < size  ) {
+			if(  data[next] == 0  ) {
+				return next++;
 			}
+			next++;
 		}
 
 		if (size < 65535)
 		{
-			// Enlarge the array before searching old handles.
+			// Enlarge the array before reusing old handles.
 			// This is slightly less efficient, but minimises handle
 			// duplication, which can cause problems when handles are
 			// used as indices.
 			return enlarge();
 		}
 
-		// scan whole array
-		for(  i=1;  i<size;  i++  ) {
-			if(  data[i]==0  ) {
-				next = i+1;
+		// reuse the entry which was freed first
+		uint16 i = pop_free();
+		if(  i == 0  ) {
+			// entries which were free on loading are not in the list yet
+			for(  i=1;  i<size;  i++  ) {
+				if(  data[i] == 0  ) {
+					append_free( i );
+				}
+			}
+			i = pop_free();
+		}
+		if(  i == 0  ) {
+			dbg->fatal("quickstone<T>::find_next()","no free index found (size=%i)",size);
+		}
+		return i;
+	}
+
+	/// @returns the first freed entry which is still free, or 0
+	static uint16 pop_free()
+	{
+		while(  free_head != 0  ) {
+			const uint16 i = free_head;
+			free_head = free_links[i];
+			if(  free_head == 0  ) {
+				free_tail = 0;
+			}
+			free_links[i] = NOT_LISTED;
+			if(  data[i] == 0  ) {
 				return i;
 			}
 		}
-		return enlarge();
+		return 0;
+	}
+
+	static void append_free(uint16 i)
+	{
+		if(  free_links[i] != NOT_LISTED  ) {
+			// still in the list from an earlier detach
+			return;
+		}
+		free_links[i] = 0;
+		if(  free_tail != 0  ) {
+			free_links[free_tail] = i;
+		}
+		else {
+			free_head = i;
+		}
+		free_tail = i;
 	}
 
 	static uint16 enlarge()
@@ -96,11 +156,16 @@ private:
 		// Move data to new extended array
 		T ** newdata = new T* [newsize];
 		memcpy( newdata, data, sizeof(T*)*size );
+		uint16 *newlinks = new uint16 [newsize];
+		memcpy( newlinks, free_links, sizeof(uint16)*size );
 		for(  uint16 i=size;  i<newsize;  i++  ) {
 			newdata[i] = 0;
+			newlinks[i] = NOT_LISTED;
 		}
 		delete [] data;
 		data = newdata;
+		delete [] free_links;
+		free_links = newlinks;
 		next = size+1;
 		size = newsize;
 		return next-1;
@@ -116,13 +181,17 @@ public:
 	static void init(const uint16 n)
 	{
 		delete [] data;
+		delete [] free_links;
 		size = n;
 		data = new T* [size];
+		free_links = new uint16 [size];
 
 		// all NULL pointers are mapped to entry 0
 		for(int i=0; i<size; i++) {
 			data[i] = 0;
+			free_links[i] = NOT_LISTED;
 		}
+		free_head = free_tail = 0;
 		next = 1;
 	}
 
@@ -198,8 +267,8 @@ public:
 	// returns true, if no handles left
 	static bool is_exhausted()
 	{
-		if(  size==65535  ) {
-			// scan  array
+		if(  size==65535  &&  next>=size  &&  free_head==0  ) {
+			// scan  array, entries which were free on loading are not listed
 			for(  uint16 i = 1; i<size; i++) {
 				if(data[i] == 0) {
 					// still empty handles left
@@ -209,7 +278,7 @@ public:
 			// no handles left => cannot extend
 			return true;
 		}
-		// can extend in any case => ok
+		// can extend or reuse in any case => ok
 		return false;
 	}
 
@@ -231,7 +300,10 @@ public:
 	T* detach()
 	{
 		T* p = data[entry];
-		data[entry] = 0;
+		if(  p  ) {
+			data[entry] = 0;
+			append_free( entry );
+		}
 		return p;
 	}
 
@@ -297,10 +369,14 @@ public:
 	 * For checking the consistency of handle allocation
 	 * among the server and the clients in network mode
 	 */
-	static uint16 get_next_check() { return next; }
+	static uint16 get_next_check() { return next < size ? next : free_head; }
 };
 
 template <class T> T** quickstone_tpl<T>::data = 0;
+template <class T> uint16 *quickstone_tpl<T>::free_links = 0;
+
+template <class T> uint16 quickstone_tpl<T>::free_head = 0;
+template <class T> uint16 quickstone_tpl<T>::free_tail = 0;
 
 template <class T> uint16 quickstone_tpl<T>::next = 1;
 template <class T> uint16 quickstone_tpl<T>::size = 0;
@@ -23,16 +23,12 @@ public:
 
 	static uint32 hash(const char *key)
 	{
-		uint32 hash = 0;
-#if 1
-		for(  sint8 i=16;  i*key[0]!=0;  i--  ) {
-			hash += (uint8)(*key++);
-		}
-#else
+		// the whole string is needed: the sum of the first characters gave far
+		// too many collisions for an open addressing table
+		uint32 hash = 5381;
 		while (*key != '\0') {
-			hash = hash * 33 + *key++;
+			hash = hash * 33 + (uint8)*key++;
 		}
-#endif
 		return hash;
 	}
 
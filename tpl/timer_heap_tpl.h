@@ -0,0 +1,117 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef TPL_TIMER_HEAP_TPL_H
+#define TPL_TIMER_HEAP_TPL_H
+
+
+#include "../simtypes.h"
+#include "vector_tpl.h"
+
+
+/**
+ * Items which are due at a certain tick, for deadline checks which would
+ * otherwise scan a whole list every step. A binary min-heap on the tick;
+ * the earliest item is at the top. Items due at the same tick come out in
+ * a deterministic order, which only depends on the order of the calls.
+ */
+template <class T>
+class timer_heap_tpl
+{
+	struct node_t
+	{
+		sint64 tick;
+		T item;
+	};
+
+	vector_tpl<node_t> nodes;
+
+	void sift_up(uint32 i)
+	{
+		const node_t node = nodes[i];
+		while(  i > 0  ) {
+			const uint32 parent = (i - 1) / 2;
+			if(  nodes[parent].tick <= node.tick  ) {
+				break;
+			}
+			nodes[i] = nodes[parent];
+			i = parent;
+		}
+		nodes[i] = node;
+	}
+
+	void sift_down(uint32 i)
+	{
+		const node_t node = nodes[i];
+		const uint32 count = nodes.get_count();
+		for(  uint32 child = 2 * i + 1;  child < count;  child = 2 * i + 1  ) {
+			if(  child + 1 < count  &&  nodes[child + 1].tick < nodes[child].tick  ) {
+				child++;
+			}
+			if(  node.tick <= nodes[child].tick  ) {
+				break;
+			}
+			nodes[i] = nodes[child];
+			i = child;
+		}
+		nodes[i] = node;
+	}
+
+public:
+	void insert(sint64 tick, const T &item)
+	{
+		node_t node;
+		node.tick = tick;
+		node.item = item;
+		nodes.append( node );
+		sift_up( nodes.get_count() - 1 );
+	}
+
+	/// @returns true if the earliest item is due before now
+	bool is_due(sint64 now) const { return !nodes.empty()  &&  nodes[0].tick < now; }
+
+	sint64 get_next_tick() const { return nodes[0].tick; }
+
+	/// removes and returns the earliest item
+	T pop()
+	{
+		const T item = nodes[0].item;
+		nodes[0] = nodes.back();
+		nodes.pop_back();
+		if(  !nodes.empty()  ) {
+			sift_down( 0 );
+		}
+		return item;
+	}
+
+	/// removes all entries of item, in linear time
+	bool remove(const T &item)
+	{
+		bool found = false;
+		for(  uint32 i = 0;  i < nodes.get_count();  ) {
+			if(  nodes[i].item == item  ) {
+				nodes.remove_at( i, false );
+				found = true;
+			}
+			else {
+				i++;
+			}
+		}
+		if(  found  ) {
+			for(  uint32 i = nodes.get_count() / 2;  i-- > 0;  ) {
+				sift_down( i );
+			}
+		}
+		return found;
+	}
+
+	void clear() { nodes.clear(); }
+
+	uint32 get_count() const { return nodes.get_count(); }
+
+	bool empty() const { return nodes.empty(); }
+};
+
+#endif
@@ -20,22 +20,6 @@
 #include "log.h"
 #include "../simdebug.h"
 
-/**
- * writes important messages to stderr
- */
-void log_t::important(const char* format, ...)
-{
-	va_list argptr;
-
-	va_start( argptr, format );
-
-	vfprintf( stderr, format, argptr );
-	fprintf( stderr, "\n" );
-	if (  force_flush  ) { fflush( stderr ); }
-
-	va_end( argptr );
-}
-
 /**
  * writes a debug message to stderr
  */
@@ -158,6 +142,12 @@ log_t::log_t( const char *logfilename, bool force_flush, bool log_debug, bool lo
 }
 
 
+void log_t::doubled( const char *what, const char *name )
+{
+	fprintf( stderr, "Overlaid %s \"%s\"\n", what, name );
+}
+
+
 void log_t::close()
 {
 }
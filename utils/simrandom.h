@@ -44,6 +44,30 @@ uint32 simrand_plain();
 /// reads/writes the sate of the random number generator
 void simrand_rdwr(loadsave_t *file);
 
+/**
+ * Random numbers for one of several tasks which run in parallel (splitmix64).
+ * The stream only depends on the seed (usually from simrand_plain()) and the
+ * task number, so the results do not depend on the order of the tasks.
+ */
+class simrand_stream_t
+{
+	uint64 state;
+
+public:
+	simrand_stream_t(uint32 seed, uint32 task) : state( ((uint64)seed << 32) ^ ((uint64)task * 0x9E3779B97F4A7C15ull) ) {}
+
+	uint32 next()
+	{
+		uint64 z = (state += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return (uint32)((z ^ (z >> 31)) >> 32);
+	}
+
+	/// random number on [0,max-1], like simrand()
+	uint32 rand(uint32 max) { return max <= 1 ? 0 : next() % max; }
+};
+
 double perlin_noise_2D(const double x, const double y, const double persistence, const sint32 map_size = 512);
 
 // for network debugging, i.e. finding hidden simrands in wrong places
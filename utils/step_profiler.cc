@@ -0,0 +1,260 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <string.h>
+#include <algorithm>
+
+#include "step_profiler.h"
+#include "csv.h"
+#include "simstring.h"
+#include "../simdebug.h"
+#include "../macros.h"
+#include "../sys/simsys.h"
+
+
+static const struct {
+	const char *name;
+	step_phase_t parent; // MAX_STEP_PHASES for the top level
+} phase_desc[MAX_STEP_PHASES] = {
+	{ "step",                       MAX_STEP_PHASES },
+	{ "new month",                  PHASE_STEP },
+	{ "private car routes",         PHASE_STEP },
+	{ "seasons",                    PHASE_STEP },
+	{ "await path explorer",        PHASE_STEP },
+	{ "await convoy threads",       PHASE_STEP },
+	{ "convoys",                    PHASE_STEP },
+	{ "cities",                     PHASE_STEP },
+	{ "await private car routes",   PHASE_STEP },
+	{ "travel times",               PHASE_STEP },
+	{ "passengers and mail",        PHASE_STEP },
+	{ "await passengers and mail",  PHASE_STEP },
+	{ "factories",                  PHASE_STEP },
+	{ "production",                 PHASE_FACTORIES },
+	{ "distribution",               PHASE_FACTORIES },
+	{ "powernet",                   PHASE_STEP },
+	{ "players",                    PHASE_STEP },
+	{ "halts",                      PHASE_STEP },
+	{ "transfers",                  PHASE_STEP },
+	{ "start threads",              PHASE_STEP },
+	{ "signals",                    PHASE_STEP },
+	{ "scenario",                   PHASE_STEP },
+	{ "sync step",                  MAX_STEP_PHASES }
+};
+
+
+uint64 step_profiler_t::current[MAX_STEP_PHASES];
+uint64 step_profiler_t::history[HISTORY][MAX_STEP_PHASES];
+uint64 step_profiler_t::total[MAX_STEP_PHASES];
+uint32 step_profiler_t::steps = 0;
+uint32 step_profiler_t::export_interval = 0;
+char step_profiler_t::export_filename[256];
+
+
+step_profiler_scope_t::step_profiler_scope_t(step_phase_t phase) :
+	phase(phase),
+	start(dr_time_us())
+{
+}
+
+
+step_profiler_scope_t::~step_profiler_scope_t()
+{
+	step_profiler_t::add_time( phase, dr_time_us() - start );
+}
+
+
+void step_profiler_t::end_step()
+{
+	memcpy( history[steps % HISTORY], current, sizeof(current) );
+	for(  int p = 0;  p < MAX_STEP_PHASES;  p++  ) {
+		total[p] += current[p];
+	}
+	memset( current, 0, sizeof(current) );
+	steps++;
+
+	if(  export_interval  &&  (steps % export_interval) == 0  ) {
+		const size_t len = strlen( export_filename );
+		const bool ok = len > 5  &&  STRICMP( export_filename + len - 5, ".json" ) == 0 ? write_json( export_filename ) : write_csv( export_filename );
+		if(  !ok  ) {
+			dbg->warning( "step_profiler_t::end_step()", "Cannot write '%s'", export_filename );
+		}
+	}
+}
+
+
+void step_profiler_t::reset()
+{
+	memset( current, 0, sizeof(current) );
+	memset( history, 0, sizeof(history) );
+	memset( total, 0, sizeof(total) );
+	steps = 0;
+}
+
+
+const char *step_profiler_t::get_name(step_phase_t phase)
+{
+	return phase_desc[phase].name;
+}
+
+
+uint8 step_profiler_t::get_depth(step_phase_t phase)
+{
+	uint8 depth = 0;
+	while(  phase_desc[phase].parent != MAX_STEP_PHASES  ) {
+		phase = phase_desc[phase].parent;
+		depth++;
+	}
+	return depth;
+}
+
+
+uint64 step_profiler_t::get_last(step_phase_t phase)
+{
+	return steps ? history[(steps - 1) % HISTORY][phase] : 0;
+}
+
+
+uint64 step_profiler_t::get_average(step_phase_t phase)
+{
+	const uint32 n = get_steps();
+	if(  n == 0  ) {
+		return 0;
+	}
+	uint64 sum = 0;
+	for(  uint32 i = 0;  i < n;  i++  ) {
+		sum += history[i][phase];
+	}
+	return sum / n;
+}
+
+
+uint64 step_profiler_t::get_max(step_phase_t phase)
+{
+	uint64 max_us = 0;
+	for(  uint32 i = 0;  i < get_steps();  i++  ) {
+		max_us = std::max( max_us, history[i][phase] );
+	}
+	return max_us;
+}
+
+
+uint64 step_profiler_t::get_percentile(step_phase_t phase, uint32 percent)
+{
+	const uint32 n = get_steps();
+	if(  n == 0  ) {
+		return 0;
+	}
+	uint64 samples[HISTORY];
+	for(  uint32 i = 0;  i < n;  i++  ) {
+		samples[i] = history[i][phase];
+	}
+	const uint32 k = std::min( n - 1, (n * std::min( percent, 100u )) / 100 );
+	std::nth_element( samples, samples + k, samples + n );
+	return samples[k];
+}
+
+
+void step_profiler_t::get_histogram(step_phase_t phase, uint32 (&buckets)[HISTOGRAM_BUCKETS])
+{
+	memset( buckets, 0, sizeof(buckets) );
+	for(  uint32 i = 0;  i < get_steps();  i++  ) {
+		uint32 b = 0;
+		while(  b < HISTOGRAM_BUCKETS - 1  &&  history[i][phase] >= (1ull << b)  ) {
+			b++;
+		}
+		buckets[b]++;
+	}
+}
+
+
+bool step_profiler_t::write_csv(const char *filename)
+{
+	CSV_t csv;
+	csv.add_field( "phase" );
+	csv.add_field( "parent" );
+	csv.add_field( "depth" );
+	csv.add_field( "last_us" );
+	csv.add_field( "avg_us" );
+	csv.add_field( "p50_us" );
+	csv.add_field( "p95_us" );
+	csv.add_field( "max_us" );
+	for(  int b = 0;  b < HISTOGRAM_BUCKETS;  b++  ) {
+		char head[32];
+		if(  b < HISTOGRAM_BUCKETS - 1  ) {
+			sprintf( head, "lt_%llu_us", 1ull << b );
+		}
+		else {
+			sprintf( head, "ge_%llu_us", 1ull << (b - 1) );
+		}
+		csv.add_field( head );
+	}
+	csv.new_line();
+
+	for(  int p = 0;  p < MAX_STEP_PHASES;  p++  ) {
+		const step_phase_t phase = (step_phase_t)p;
+		char num[32];
+		csv.add_field( get_name(phase) );
+		csv.add_field( phase_desc[p].parent == MAX_STEP_PHASES ? "" : get_name(phase_desc[p].parent) );
+		csv.add_field( get_depth(phase) );
+		const uint64 values[] = { get_last(phase), get_average(phase), get_percentile(phase, 50), get_percentile(phase, 95), get_max(phase) };
+		for(  size_t i = 0;  i < lengthof(values);  i++  ) {
+			sprintf( num, "%llu", (unsigned long long)values[i] );
+			csv.add_field( num );
+		}
+		uint32 buckets[HISTOGRAM_BUCKETS];
+		get_histogram( phase, buckets );
+		for(  int b = 0;  b < HISTOGRAM_BUCKETS;  b++  ) {
+			csv.add_field( (int)buckets[b] );
+		}
+		csv.new_line();
+	}
+
+	FILE *f = dr_fopen( filename, "w" );
+	if(  !f  ) {
+		return false;
+	}
+	fputs( csv.get_str(), f );
+	fclose( f );
+	return true;
+}
+
+
+bool step_profiler_t::write_json(const char *filename)
+{
+	FILE *f = dr_fopen( filename, "w" );
+	if(  !f  ) {
+		return false;
+	}
+	fprintf( f, "{\n\t\"steps\": %u,\n\t\"phases\": [\n", get_steps() );
+	for(  int p = 0;  p < MAX_STEP_PHASES;  p++  ) {
+		const step_phase_t phase = (step_phase_t)p;
+		fprintf( f, "\t\t{ \"name\": \"%s\", \"parent\": ", get_name(phase) );
+		if(  phase_desc[p].parent == MAX_STEP_PHASES  ) {
+			fprintf( f, "null" );
+		}
+		else {
+			fprintf( f, "\"%s\"", get_name(phase_desc[p].parent) );
+		}
+		fprintf( f, ", \"last_us\": %llu, \"avg_us\": %llu, \"p50_us\": %llu, \"p95_us\": %llu, \"max_us\": %llu, \"histogram_log2_us\": [",
+			(unsigned long long)get_last(phase), (unsigned long long)get_average(phase),
+			(unsigned long long)get_percentile(phase, 50), (unsigned long long)get_percentile(phase, 95), (unsigned long long)get_max(phase) );
+		uint32 buckets[HISTOGRAM_BUCKETS];
+		get_histogram( phase, buckets );
+		for(  int b = 0;  b < HISTOGRAM_BUCKETS;  b++  ) {
+			fprintf( f, b ? ", %u" : "%u", buckets[b] );
+		}
+		fprintf( f, "] }%s\n", p + 1 < MAX_STEP_PHASES ? "," : "" );
+	}
+	fprintf( f, "\t]\n}\n" );
+	fclose( f );
+	return true;
+}
+
+
+void step_profiler_t::set_export(uint32 interval, const char *filename)
+{
+	export_interval = interval;
+	tstrncpy( export_filename, filename, lengthof(export_filename) );
+}
@@ -0,0 +1,126 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_STEP_PROFILER_H
+#define UTILS_STEP_PROFILER_H
+
+
+#include "../simtypes.h"
+
+class cbuffer_t;
+
+
+/**
+ * The timed phases of karte_t::step(). The order is the display order;
+ * the hierarchy is given by the parent of each phase in step_profiler.cc.
+ * The AWAIT phases are the time the main thread waits for a thread pool.
+ */
+enum step_phase_t {
+	PHASE_STEP,
+	PHASE_NEW_MONTH,
+	PHASE_PRIVATE_CAR_ROUTES,
+	PHASE_SEASONS,
+	PHASE_PATH_EXPLORER,
+	PHASE_CONVOYS_THREADED,
+	PHASE_CONVOYS,
+	PHASE_CITIES,
+	PHASE_AWAIT_PRIVATE_CARS,
+	PHASE_TRAVEL_TIMES,
+	PHASE_PASSENGERS_MAIL,
+	PHASE_AWAIT_PASSENGERS_MAIL,
+	PHASE_FACTORIES,
+	PHASE_FACTORY_PRODUCTION,
+	PHASE_FACTORY_DISTRIBUTION,
+	PHASE_POWERNET,
+	PHASE_PLAYERS,
+	PHASE_HALTS,
+	PHASE_TRANSFERS,
+	PHASE_START_THREADS,
+	PHASE_SIGNALS,
+	PHASE_SCENARIO,
+	PHASE_SYNC_STEP,
+	MAX_STEP_PHASES
+};
+
+
+/**
+ * Always compiled timing of the step phases. Each phase accumulates its
+ * time during a step; end_step() moves the sums into a ring buffer of the
+ * last HISTORY steps, from which averages, percentiles and histograms are
+ * calculated on demand.
+ *
+ * Only to be used from the main thread.
+ */
+class step_profiler_t
+{
+public:
+	enum {
+		HISTORY = 256,
+		/// bucket i counts the steps with less than 2^i microseconds, the last one the rest
+		HISTOGRAM_BUCKETS = 24
+	};
+
+	static void add_time(step_phase_t phase, uint64 us) { current[phase] += us; }
+
+	/// closes the current step, and writes the export file if due
+	static void end_step();
+
+	/// forgets all samples, e.g. after loading
+	static void reset();
+
+	static const char *get_name(step_phase_t phase);
+	static uint8 get_depth(step_phase_t phase);
+
+	/// number of steps in the history
+	static uint32 get_steps() { return steps < HISTORY ? steps : (uint32)HISTORY; }
+
+	/// all steps since the last reset, not only the history
+	static uint32 get_total_steps() { return steps; }
+	static uint64 get_total(step_phase_t phase) { return total[phase]; }
+
+	static uint64 get_last(step_phase_t phase);
+	static uint64 get_average(step_phase_t phase);
+	static uint64 get_max(step_phase_t phase);
+	/// @param percent 0..100
+	static uint64 get_percentile(step_phase_t phase, uint32 percent);
+	static void get_histogram(step_phase_t phase, uint32 (&buckets)[HISTOGRAM_BUCKETS]);
+
+	static bool write_csv(const char *filename);
+	static bool write_json(const char *filename);
+
+	/**
+	 * Writes the statistics to filename every interval steps (0 = never).
+	 * JSON if the name ends in .json, otherwise CSV.
+	 */
+	static void set_export(uint32 interval, const char *filename);
+
+private:
+	static uint64 current[MAX_STEP_PHASES];
+	static uint64 history[HISTORY][MAX_STEP_PHASES];
+	static uint64 total[MAX_STEP_PHASES];
+	static uint32 steps;
+	static uint32 export_interval;
+	static char export_filename[256];
+};
+
+
+/**
+ * Adds the time until it goes out of scope to a phase.
+ */
+class step_profiler_scope_t
+{
+	step_phase_t phase;
+	uint64 start;
+
+public:
+	explicit step_profiler_scope_t(step_phase_t phase);
+	~step_profiler_scope_t();
+};
+
+#define STEP_PROFILE_CONCAT_(a, b) a##b
+#define STEP_PROFILE_CONCAT(a, b) STEP_PROFILE_CONCAT_(a, b)
+#define STEP_PROFILE(phase) step_profiler_scope_t STEP_PROFILE_CONCAT(step_profile_, __LINE__)(phase)
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "task_pool.h"
+#include "simrandom.h"
+#include "../simdebug.h"
+#include "../dataobj/route.h"
+
+
+thread_local bool task_pool_t::in_task = false;
+
+task_pool_t::task_pool_t(uint32 wanted_threads) :
+	func(NULL),
+	data(NULL),
+	count(0),
+	thread_count(1)
+{
+#ifdef MULTI_THREAD
+	generation = 0;
+	next_task = 0;
+	unfinished = 0;
+	terminate = false;
+	pthread_mutex_init( &mutex, NULL );
+	pthread_cond_init( &start_cond, NULL );
+	pthread_cond_init( &done_cond, NULL );
+
+	if(  wanted_threads > MAX_THREADS  ) {
+		wanted_threads = MAX_THREADS;
+	}
+	for(  ;  thread_count < wanted_threads;  thread_count++  ) {
+		if(  pthread_create( &this->threads[thread_count - 1], NULL, thread_loop, this )  ) {
+			dbg->warning( "task_pool_t::task_pool_t()", "cannot start thread #%u, continuing with fewer threads", thread_count );
+			break;
+		}
+	}
+#else
+	(void)wanted_threads;
+#endif
+}
+
+
+task_pool_t::~task_pool_t()
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &mutex );
+	terminate = true;
+	pthread_cond_broadcast( &start_cond );
+	pthread_mutex_unlock( &mutex );
+
+	for(  uint32 t = 0;  t + 1 < thread_count;  t++  ) {
+		pthread_join( threads[t], NULL );
+	}
+	pthread_cond_destroy( &done_cond );
+	pthread_cond_destroy( &start_cond );
+	pthread_mutex_destroy( &mutex );
+#endif
+}
+
+
+void task_pool_t::run(task_func f, void *d, uint32 n)
+{
+	if(  n == 0  ) {
+		return;
+	}
+
+	// tasks must not touch the global random numbers
+	const uint16 old_random_mode = get_random_mode();
+	set_random_mode( INTERACTIVE_RANDOM );
+
+#ifdef MULTI_THREAD
+	if(  thread_count > 1  &&  n > 1  ) {
+		pthread_mutex_lock( &mutex );
+		func = f;
+		data = d;
+		count = n;
+		next_task = 0;
+		unfinished = n;
+		generation++;
+		pthread_cond_broadcast( &start_cond );
+
+		work();
+		while(  unfinished > 0  ) {
+			pthread_cond_wait( &done_cond, &mutex );
+		}
+		func = NULL;
+		pthread_mutex_unlock( &mutex );
+	}
+	else
+#endif
+	{
+		in_task = true;
+		for(  uint32 i = 0;  i < n;  i++  ) {
+			f( d, i );
+		}
+		in_task = false;
+	}
+
+	if(  (old_random_mode & INTERACTIVE_RANDOM) == 0  ) {
+		clear_random_mode( INTERACTIVE_RANDOM );
+	}
+}
+
+
+#ifdef MULTI_THREAD
+void task_pool_t::work()
+{
+	while(  next_task < count  ) {
+		const uint32 task = next_task++;
+		pthread_mutex_unlock( &mutex );
+
+		in_task = true;
+		func( data, task );
+		in_task = false;
+
+		pthread_mutex_lock( &mutex );
+		if(  --unfinished == 0  ) {
+			pthread_cond_signal( &done_cond );
+		}
+	}
+}
+
+
+void *task_pool_t::thread_loop(void *ptr)
+{
+	task_pool_t *pool = reinterpret_cast<task_pool_t *>(ptr);
+
+	pthread_mutex_lock( &pool->mutex );
+	// a run() may have started before this thread
+	uint32 seen_generation = 0;
+	while(  true  ) {
+		while(  !pool->terminate  &&  seen_generation == pool->generation  ) {
+			pthread_cond_wait( &pool->start_cond, &pool->mutex );
+		}
+		if(  pool->terminate  ) {
+			break;
+		}
+		seen_generation = pool->generation;
+		pool->work();
+	}
+	pthread_mutex_unlock( &pool->mutex );
+
+	// the route nodes are thread local and would leak otherwise
+	route_t::TERM_NODES();
+	return NULL;
+}
+#endif
@@ -0,0 +1,73 @@
+/*
+ * This file is part of the Simutrans-Extended project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_TASK_POOL_H
+#define UTILS_TASK_POOL_H
+
+
+#include "../simtypes.h"
+#include "../simconst.h"
+#include "simthread.h"
+
+
+/**
+ * A set of threads which run numbered tasks, for the generation of new maps
+ * (before the threads of the running game exist). run() blocks until all
+ * tasks are done; the calling thread works on them as well.
+ *
+ * Tasks must only read shared data and write to their own results. Then the
+ * results do not depend on the number of threads, nor on which thread ran
+ * which task. The global simrand() must not be used by a task, use a
+ * simrand_stream_t for each task instead.
+ *
+ * Each thread has its own route nodes and marker, so route searches can
+ * run in tasks. The threads free their route nodes when the pool is deleted.
+ */
+class task_pool_t
+{
+public:
+	typedef void (*task_func)(void *data, uint32 task);
+
+	/// starts threads-1 additional threads
+	explicit task_pool_t(uint32 wanted_threads);
+	~task_pool_t();
+
+	uint32 get_thread_count() const { return thread_count; }
+
+	/// runs func(data, 0) ... func(data, count-1)
+	void run(task_func func, void *data, uint32 count);
+
+	/// @returns true while the calling thread runs a task of any pool
+	static bool is_in_task() { return in_task; }
+
+private:
+	static thread_local bool in_task;
+
+	task_func func;
+	void *data;
+	uint32 count;
+
+	uint32 thread_count;
+
+#ifdef MULTI_THREAD
+	static void *thread_loop(void *ptr);
+
+	/// takes and runs tasks until none are left; called with the mutex locked
+	void work();
+
+	pthread_t threads[MAX_THREADS];
+	pthread_mutex_t mutex;
+	pthread_cond_t start_cond;
+	pthread_cond_t done_cond;
+
+	/// increased by every run(), so the threads notice new work
+	uint32 generation;
+	uint32 next_task;
+	uint32 unfinished;
+	bool terminate;
+#endif
+};
+
+#endif
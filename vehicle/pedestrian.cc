@@ -11,6 +11,7 @@
 
 #include "../utils/simrandom.h"
 #include "../boden/grund.h"
+#include "../dataobj/freelist.h"
 #include "../dataobj/loadsave.h"
 #include "../dataobj/environment.h"
 #include "../dataobj/translator.h"
@@ -105,6 +106,18 @@ pedestrian_t::pedestrian_t(grund_t *gr, uint32 time_to_live) :
 }
 
 
+void* pedestrian_t::operator new(size_t s)
+{
+	return freelist_t::gimme_node(s);
+}
+
+
+void pedestrian_t::operator delete(void* p, size_t s)
+{
+	freelist_t::putback_node(s, p);
+}
+
+
 pedestrian_t::~pedestrian_t()
 {
 	if(  time_to_life>0  ) {
@@ -83,6 +83,9 @@ public:
 	static void generate_pedestrians_at(koord3d k, uint32 count, uint32 time_to_live);
 
 	static void check_timeline_pedestrians();
+
+	void* operator new(size_t s);
+	void  operator delete(void* p, size_t s);
 };
 
 #endif
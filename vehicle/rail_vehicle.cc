@@ -1383,6 +1383,70 @@ void rail_vehicle_t::find_next_signal(route_t* route, uint16 start_index, uint16
  * if (!reserve && force_unreserve) then un-reserve everything till the end of the route
  * @author prissi
  */
+bool rail_vehicle_t::is_plain_block_section(const route_t *route, uint16 start_index, uint16 blocked_index) const
+{
+	if(blocked_index >= route->get_count())
+	{
+		return false;
+	}
+	for(uint32 j = start_index; j <= blocked_index; j++)
+	{
+		const grund_t* gr = welt->lookup(route->at(j));
+		const schiene_t* sch = gr ? (const schiene_t*)gr->get_weg(get_waytype()) : NULL;
+		if(sch == NULL || sch->is_crossing() || gr->get_depot())
+		{
+			return false;
+		}
+		if(j > start_index && (sch->has_sign() || sch->has_signal() || gr->is_halt()))
+		{
+			return false;
+		}
+		if(j < blocked_index && sch->get_reserved_convoi().is_bound() && sch->get_reserved_convoi() != cnv->self)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool rail_vehicle_t::is_reservation_still_blocked(const route_t *route, uint16 start_index, uint16 modified_sighting_distance_tiles, uint32 brake_steps) const
+{
+	const blocked_reservation_t &b = blocked_reservation;
+	if(!b.valid
+		|| b.route != route
+		|| b.route_revision != route->get_revision()
+		|| b.start_index != start_index
+		|| b.vehicle_pos != get_pos()
+		|| b.working_method != working_method
+		|| b.sighting_distance_tiles != modified_sighting_distance_tiles
+		|| b.brake_steps != brake_steps
+		|| b.next_stop_index != cnv->get_next_stop_index()
+		|| b.own_reserved_tiles != cnv->get_reserved_tile_count()
+		|| !b.blocker.is_bound()
+		|| b.blocked_index >= route->get_count()
+		|| route->at(start_index) != b.start_pos
+		|| route->at(b.blocked_index) != b.blocked_pos)
+	{
+		return false;
+	}
+
+	const halthandle_t this_halt = haltestelle_t::get_halt(b.start_pos, get_owner());
+	if(this_halt.is_bound() && this_halt->get_station_signals_count() > 0)
+	{
+		return false;
+	}
+
+	if(!is_plain_block_section(route, start_index, b.blocked_index))
+	{
+		return false;
+	}
+
+	const schiene_t* sch = (const schiene_t*)welt->lookup(b.blocked_pos)->get_weg(get_waytype());
+	return sch->get_reserved_convoi() == b.blocker && !sch->can_reserve(cnv->self, b.blocked_ribi);
+}
+
+
 sint32 rail_vehicle_t::block_reserver(route_t *route, uint16 start_index, uint16 modified_sighting_distance_tiles, uint16 &next_signal_index, int count, bool reserve, bool force_unreserve, bool is_choosing, bool is_from_token, bool is_from_starter, bool is_from_directional, uint32 brake_steps, uint16 first_one_train_staff_index, bool from_call_on, bool *break_loop)
 {
 	bool success = true;
@@ -1435,6 +1499,22 @@ sint32 rail_vehicle_t::block_reserver(route_t *route, uint16 start_index, uint16
 		cnv->set_next_reservation_index(start_index);
 	}
 
+	// A train waiting for a block occupied by another train: see blocked_reservation_t
+	const bool plain_block_call = reserve && !force_unreserve && count == 0 && !is_choosing && !is_from_token && !is_from_starter && !is_from_directional && !from_call_on
+		&& first_one_train_staff_index == INVALID_INDEX && break_loop == NULL && !do_early_platform_search && route == cnv->get_route()
+		&& (working_method == absolute_block || working_method == track_circuit_block || working_method == cab_signalling);
+	if(plain_block_call && is_reservation_still_blocked(route, start_index, modified_sighting_distance_tiles, brake_steps))
+	{
+		next_signal_index = blocked_reservation.next_signal_index;
+		cnv->set_next_reservation_index(blocked_reservation.curtailment_index);
+		return 0;
+	}
+	blocked_reservation.valid = false;
+	const uint16 next_stop_index_at_start = cnv->get_next_stop_index();
+	const working_method_t working_method_at_start = working_method;
+	uint16 blocked_index = INVALID_INDEX;
+	ribi_t::ribi blocked_ribi = ribi_t::none;
+
 	// find next block segment enroute
 	uint32 i = start_index - (count == 100001 ? 1 : 0);
 	next_signal_index = INVALID_INDEX;
@@ -2321,9 +2401,15 @@ sint32 rail_vehicle_t::block_reserver(route_t *route, uint16 start_index, uint16
 			bool attempt_reservation = directional_only || time_interval_reservation || previous_telegraph_directional || ((next_signal_working_method != time_interval && next_signal_working_method != time_interval_with_telegraph && ((next_signal_working_method != drive_by_sight && !transitioning_from_time_interval) || i < start_index + modified_sighting_distance_tiles + 1)) && (!stop_at_station_signal.is_bound() || stop_at_station_signal == check_halt));
 			previous_telegraph_directional = telegraph_directional;
 			previous_time_interval_reservation = time_interval_reservation ? is_true : is_false;
-			if(!reserving_beyond_a_train && attempt_reservation && !sch1->reserve(cnv->self, ribi_type(route->at(max(1u,i)-1u), route->at(min(route->get_count()-1u,i+1u))), rt, (working_method == time_interval || working_method == time_interval_with_telegraph)))
+			const ribi_t::ribi reserve_ribi = ribi_type(route->at(max(1u,i)-1u), route->at(min(route->get_count()-1u,i+1u)));
+			if(!reserving_beyond_a_train && attempt_reservation && !sch1->reserve(cnv->self, reserve_ribi, rt, (working_method == time_interval || working_method == time_interval_with_telegraph)))
 			{
 				not_entirely_free = true;
+				if(blocked_index == INVALID_INDEX)
+				{
+					blocked_index = i;
+					blocked_ribi = reserve_ribi;
+				}
 				if (from_call_on)
 				{
 					next_signal_working_method = drive_by_sight;
@@ -2881,6 +2967,33 @@ sint32 rail_vehicle_t::block_reserver(route_t *route, uint16 start_index, uint16
 				}
 				return 1;
 			}
+			if (plain_block_call && blocked_index < INVALID_INDEX && working_method == working_method_at_start && last_choose_signal_index >= INVALID_INDEX
+				&& !directional_only && station_signals == 0 && is_plain_block_section(route, start_index, blocked_index))
+			{
+				const grund_t* gr_blocked = welt->lookup(route->at(blocked_index));
+				const convoihandle_t blocker = ((const schiene_t*)gr_blocked->get_weg(get_waytype()))->get_reserved_convoi();
+				if (blocker.is_bound() && blocker != cnv->self)
+				{
+					blocked_reservation_t &b = blocked_reservation;
+					b.valid = true;
+					b.route = route;
+					b.route_revision = route->get_revision();
+					b.vehicle_pos = get_pos();
+					b.start_pos = route->at(start_index);
+					b.blocked_pos = route->at(blocked_index);
+					b.blocker = blocker;
+					b.blocked_ribi = blocked_ribi;
+					b.working_method = working_method;
+					b.start_index = start_index;
+					b.blocked_index = blocked_index;
+					b.sighting_distance_tiles = modified_sighting_distance_tiles;
+					b.next_stop_index = next_stop_index_at_start;
+					b.next_signal_index = next_signal_index;
+					b.curtailment_index = curtailment_index;
+					b.brake_steps = brake_steps;
+					b.own_reserved_tiles = cnv->get_reserved_tile_count();
+				}
+			}
 			return 0;
 		}
 	}
@@ -26,6 +26,41 @@ protected:
 
 	working_method_t working_method = drive_by_sight;
 
+	/**
+	 * The last reservation of this vehicle in block signalling which failed
+	 * because a tile was reserved by another convoy. Trying again from the
+	 * same place on the same route of our convoy (by its revision) fails in
+	 * the same way as long as that convoy keeps the tile and the tiles before
+	 * it stay plain track which is free or ours, so block_reserver() does not
+	 * walk the route again then.
+	 */
+	struct blocked_reservation_t
+	{
+		bool valid = false;
+		const route_t *route;
+		uint32 route_revision;
+		koord3d vehicle_pos;
+		koord3d start_pos;
+		koord3d blocked_pos;
+		convoihandle_t blocker;
+		ribi_t::ribi blocked_ribi;
+		working_method_t working_method;
+		uint16 start_index;
+		uint16 blocked_index;
+		uint16 sighting_distance_tiles;
+		uint16 next_stop_index;
+		uint16 next_signal_index;
+		uint16 curtailment_index;
+		uint32 brake_steps;
+		uint32 own_reserved_tiles;
+	};
+	blocked_reservation_t blocked_reservation;
+
+	/// tiles start_index..blocked_index have no signs, crossings or halts after the first, and none before the last is reserved by others
+	bool is_plain_block_section(const route_t *route, uint16 start_index, uint16 blocked_index) const;
+
+	bool is_reservation_still_blocked(const route_t *route, uint16 start_index, uint16 modified_sighting_distance_tiles, uint32 brake_steps) const;
+
 public:
 	waytype_t get_waytype() const OVERRIDE { return track_wt; }
 
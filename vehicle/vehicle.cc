@@ -1602,7 +1602,7 @@ void vehicle_t::leave_tile()
 	vehicle_base_t::leave_tile();
 #ifndef DEBUG_ROUTES
 	if(last  &&  minimap_t::get_instance()->is_visible) {
-			minimap_t::get_instance()->calc_map_pixel(get_pos().get_2d());
+			minimap_t::get_instance()->calc_convoy_pixel(get_pos().get_2d());
 	}
 #endif
 }
@@ -1615,7 +1615,7 @@ void vehicle_t::enter_tile(grund_t* gr)
 	vehicle_base_t::enter_tile(gr);
 
 	if(leading  &&  minimap_t::get_instance()->is_visible  ) {
-		minimap_t::get_instance()->calc_map_pixel( get_pos().get_2d() );
+		minimap_t::get_instance()->calc_convoy_pixel( get_pos().get_2d() );
 	}
 }
 
@@ -2997,7 +2997,7 @@ vehicle_t::~vehicle_t()
 {
 	if(!welt->is_destroying()) {
 		// remove vehicle's marker from the minimap
-		minimap_t::get_instance()->calc_map_pixel(get_pos().get_2d());
+		minimap_t::get_instance()->calc_convoy_pixel(get_pos().get_2d());
 	}
 
 	delete[] class_reassignments;